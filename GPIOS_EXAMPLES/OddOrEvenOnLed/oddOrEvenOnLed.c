@@ -11,6 +11,99 @@
  *              condition, displays the following output on LEDs:
  *                  - If the input is even, the first LED is turned on.
  *                  - If the input is odd, the second LED is turned on.
+ *
+ *              The keys can be read in six ways, selected at build time through
+ *              `KEYS_INPUT_MODE`:
+ *                  - KEYS_INPUT_POLLING: the main loop keeps sampling GPIOB->IDR
+ *                    and re-evaluates the LEDs on every pass.
+ *                  - KEYS_INPUT_EXTI: PB0..PB2 are routed to EXTI0..EXTI2 on both
+ *                    edges, so the LEDs are only updated from the interrupt
+ *                    raised by a key change and the core is free in between.
+ *                  - KEYS_INPUT_DEBOUNCED: a TIM2 interrupt samples GPIOB->IDR at
+ *                    KEYS_SAMPLE_HZ through the vertical-counter debounce engine,
+ *                    and the LEDs are only updated on a debounced key edge, so
+ *                    contact bounce no longer flips the parity output.
+ *                  - KEYS_INPUT_SCHEDULED: the same debounce engine and the
+ *                    parity evaluation run as two periodic tasks of the SysTick
+ *                    cooperative scheduler, and the core sleeps tickless between
+ *                    their releases.
+ *                  - KEYS_INPUT_MATRIX: a 4x4 keypad on PB4..PB7 (rows) and
+ *                    PB8..PB11 (columns) is scanned by TIM2, one row per
+ *                    update, and its 16-key bitmap goes through the same
+ *                    debounce engine. The scan stops while no key is down and
+ *                    a column EXTI edge restarts it, so the core sleeps.
+ *                  - KEYS_INPUT_CAPTURE: the keys move to PA0..PA2 (TIM5_CH1..
+ *                    CH3, PB2 has no timer channel), captured on both edges.
+ *                    DMA1 copies every stamp into RAM, and the main loop
+ *                    settles each key once it stayed quiet for 5 ms, keeping
+ *                    the exact press and release times without ever reading
+ *                    an IDR.
+ *
+ *              With EXTI input, `LOW_POWER_MODE` selects what the core does
+ *              while waiting for a key:
+ *                  - LOW_POWER_NONE: spins in the main loop.
+ *                  - LOW_POWER_SLEEP: executes WFI from the main loop.
+ *                  - LOW_POWER_SLEEP_ON_EXIT: sets SCB->SCR SLEEPONEXIT, so the
+ *                    core goes back to Sleep straight from the EXTI handler.
+ *                  - LOW_POWER_STOP: as above with SLEEPDEEP, entering Stop
+ *                    mode; EXTI0..EXTI2 wake it up on the next key edge.
+ *
+ *              With `LOW_POWER_WAKE_PROBE` set to 1u and PC6 jumpered to the
+ *              even LED on PC0, TIM3 captures the PB0 edge and the LED edge it
+ *              causes, and their distance is kept in nanoseconds in
+ *              `wake_latency` for the selected depth, so each sleep depth can
+ *              be built and read back with the debugger.
+ *
+ *              Building with `BENCHMARK_BUILD` set to 1u times, with the DWT
+ *              cycle counter, each main loop iteration (or key handler run),
+ *              each parity evaluation and each LED store into `bench_results`.
+ *              With `BENCHMARK_LOOPBACK` also set, PB0 and the even LED (PC0,
+ *              jumpered to PC6) are captured on both edges by TIM3, giving the
+ *              hardware key-edge-to-LED latency of key 0 in timer ticks, at
+ *              the APB1 timer clock given by clockConfigApb1TimerHz().
+ *
+ *              With `KEYS_EVENT_QUEUE` set to 1u, the EXTI or TIM2 handlers only
+ *              post timestamped key events into a lock-free SPSC ring, and the
+ *              main loop drains them in batches and drives the LEDs from the
+ *              newest one, so the parity and output work leaves interrupt
+ *              context.
+ *
+ *              With `KEYS_RULES_TABLE` set to 1u, the parity evaluation and
+ *              user_output[] give way to led_rules[], an 8-word table that
+ *              rules_table.h expands at compile time from LED_PARITY_RULE. A
+ *              keys state then costs one load whatever the rule, and another
+ *              key-to-LED behaviour is only another rule macro. The table is
+ *              indexed by the 3 pin keys, so it is not available with the
+ *              16-key bitmap of KEYS_INPUT_MATRIX.
+ *
+ *              In every mode the LED store goes through a change-detection
+ *              output stage: GPIOC is only written when the output differs
+ *              from the last one committed, and `led_output_stats` counts the
+ *              committed and the skipped stores.
+ *
+ *              Building with `TRACE_ITM_ENABLE` set to 1u emits ITM/SWO event
+ *              records for every key edge, parity result and LED store, to be
+ *              turned into latency histograms by tools/trace_decode.py. Key
+ *              edges are only traced by the event-driven modes; in polling
+ *              mode each pass emits a parity record, most of them dropped.
+ *
+ *              With `WARM_BOOT_ENABLE` set to 1u, every committed LED word is
+ *              kept in backup SRAM under a CRC. After an IWDG or WWDG reset the
+ *              LEDs are driven again with that word before the clock bring-up,
+ *              so a watchdog the application adds never blanks them.
+ *
+ *              `MEM_PLACEMENT_TABLES` and `MEM_PLACEMENT_CODE` (see
+ *              mem_placement.h) move the lookup tables to CCM RAM or SRAM and
+ *              the key handlers, with the parity and LED path they call, to
+ *              SRAM, so no key edge waits on a flash access.
+ *
+ *              The core clock is brought up to `CLOCK_PROFILE` (168 MHz by
+ *              default) before anything else runs. After a Stop mode wake-up
+ *              the key handlers run on the 16 MHz HSI and the profile is not
+ *              restored: SLEEPONEXIT sends the core back to Stop straight from
+ *              them, so a relocked PLL would only cost power. The SWO bit rate
+ *              of `TRACE_ITM_ENABLE` follows the profile clock, so a Stop build
+ *              is traced up to its first wake-up.
  * 
  *  @file       oddOrEvenOnLed.c
  * 
@@ -24,12 +117,25 @@
  * ========================================== */
 
 /* Dependencies of libc */
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
+#include <stdint.h>
 
 /* Implementeds */
 #include "stm32f4xx.h"
+#include "parity.h"
+#include "gpio_output.h"
+#include "gpio_pin.h"
+#include "debounce.h"
+#include "cycle_bench.h"
+#include "clock_config.h"
+#include "spsc_ring.h"
+#include "scheduler.h"
+#include "output_stage.h"
+#include "trace_itm.h"
+#include "keypad_matrix.h"
+#include "warm_boot.h"
+#include "edge_capture.h"
+#include "mem_placement.h"
+#include "rules_table.h"
 
 /*==========================================
  *             Private Defines
@@ -40,31 +146,431 @@
 
 #define MAX_KEY_CONDITIONS  (uint8_t)(2u)
 
+/* 1u drives the LEDs from led_rules[], one load per keys state */
+#ifndef KEYS_RULES_TABLE
+#define KEYS_RULES_TABLE    0u
+#endif
+
+/* One input per key of KEYS_MASK */
+#define KEYS_RULES_INPUTS   3
+
+/* Rule of led_rules[]: the words of user_output[], from the keys parity */
+#define LED_PARITY_RULE(keys)                                                  \
+    GPIO_BSRR_WORD(LEDS_MASK, (RULES_PARITY8(keys) != 0u) ? 0b10u : 0b01u)
+
+/* Core clock profile, one of clock_profile_t */
+#ifndef CLOCK_PROFILE
+#define CLOCK_PROFILE       CLOCK_PROFILE_MAX_PERFORMANCE
+#endif
+
+/* Key input modes, kept as plain literals so they can be tested by #if */
+#define KEYS_INPUT_POLLING  0u
+#define KEYS_INPUT_EXTI     1u
+#define KEYS_INPUT_DEBOUNCED 2u
+#define KEYS_INPUT_SCHEDULED 3u
+#define KEYS_INPUT_MATRIX   4u
+#define KEYS_INPUT_CAPTURE  5u
+
+#ifndef KEYS_INPUT_MODE
+#define KEYS_INPUT_MODE     KEYS_INPUT_POLLING
+#endif
+
+/* All three key lines share one priority so they never preempt each other */
+#define KEYS_EXTI_PRIORITY  (uint32_t)(2u)
+
+/* Debounce sampling: 1 kHz gives a 4 ms filter with DEBOUNCE_SAMPLES = 4 */
+#define KEYS_SAMPLE_HZ      (uint32_t)(1000u)
+#define KEYS_TIMER_TICK_HZ  (uint32_t)(1000000u)
+#define KEYS_TIMER_PRIORITY (uint32_t)(2u)
+
+/* Scheduled input: 1 ms ticks, 5 ms sampling gives a 20 ms debounce filter */
+#define SCHED_TICK_HZ       (uint32_t)(1000u)
+#define SCHED_PRIORITY      (uint32_t)(3u)
+#define SCHED_SAMPLE_TICKS  (uint32_t)(5u)
+#define SCHED_PARITY_TICKS  (uint32_t)(20u)
+#define SCHED_TASK_BUDGET   (uint32_t)(200u)    /* Cycles allowed per task run */
+
+/* Keypad matrix: 1 kHz row updates scan the 4 rows at 250 frames/s */
+#define MATRIX_ROW_SHIFT    (uint8_t)(4u)
+#define MATRIX_COL_SHIFT    (uint8_t)(8u)
+#define MATRIX_LINES        (uint8_t)(4u)
+#define MATRIX_KEYS_MASK    (uint16_t)(0xFFFFu)
+#define MATRIX_SCAN_HZ      (uint32_t)(250u)
+#define MATRIX_PRIORITY     (uint32_t)(2u)
+#define MATRIX_IDLE_FRAMES  (uint8_t)(8u)       /* More than DEBOUNCE_SAMPLES, releases are seen */
+
+/* Edge capture: unprescaled TIM5, a key settles after 5 ms without edges */
+#define CAPTURE_LANES       (uint8_t)(3u)
+#define CAPTURE_SETTLE_HZ   (uint32_t)(200u)
+#define CAPTURE_FILTER      (uint8_t)(15u)      /* fDTS/32, N = 8: ~3 us glitches dropped */
+#define CAPTURE_DMA_CHANNEL (uint8_t)(6u)       /* TIM5 requests on DMA1 */
+
+/* Low-power runtime modes, only meaningful with KEYS_INPUT_EXTI */
+#define LOW_POWER_NONE          0u
+#define LOW_POWER_SLEEP         1u
+#define LOW_POWER_SLEEP_ON_EXIT 2u
+#define LOW_POWER_STOP          3u
+
+#ifndef LOW_POWER_MODE
+#define LOW_POWER_MODE      LOW_POWER_NONE
+#endif
+
+/* Stop mode regulator: 1u uses the low-power regulator (slower wake-up) */
+#ifndef LOW_POWER_STOP_LPDS
+#define LOW_POWER_STOP_LPDS 0u
+#endif
+
+/* 1u captures PB0 and PC0 (jumpered to PC6) with TIM3 into wake_latency */
+#ifndef LOW_POWER_WAKE_PROBE
+#define LOW_POWER_WAKE_PROBE    0u
+#endif
+
+#if (LOW_POWER_MODE != LOW_POWER_NONE) && (KEYS_INPUT_MODE != KEYS_INPUT_EXTI)
+#error "LOW_POWER_MODE requires KEYS_INPUT_MODE == KEYS_INPUT_EXTI"
+#endif
+
+#if (LOW_POWER_WAKE_PROBE == 1u) && (LOW_POWER_MODE == LOW_POWER_NONE)
+#error "LOW_POWER_WAKE_PROBE requires LOW_POWER_MODE != LOW_POWER_NONE"
+#endif
+
+/* Benchmark build: 1u records cycle statistics into bench_results */
+#ifndef BENCHMARK_BUILD
+#define BENCHMARK_BUILD     0u
+#endif
+
+/* 1u also captures PB0 and PC0 (jumpered to PC6) with TIM3 */
+#ifndef BENCHMARK_LOOPBACK
+#define BENCHMARK_LOOPBACK  0u
+#endif
+
+#if (BENCHMARK_LOOPBACK == 1u) && (BENCHMARK_BUILD != 1u)
+#error "BENCHMARK_LOOPBACK requires BENCHMARK_BUILD == 1u"
+#endif
+
+#if (BENCHMARK_LOOPBACK == 1u) && (KEYS_INPUT_MODE == KEYS_INPUT_CAPTURE)
+#error "BENCHMARK_LOOPBACK captures PB0, which KEYS_INPUT_CAPTURE does not read"
+#endif
+
+#if (KEYS_RULES_TABLE == 1u) && (KEYS_INPUT_MODE == KEYS_INPUT_MATRIX)
+#error "KEYS_RULES_TABLE indexes the 3 pin keys, not the 16-key bitmap of KEYS_INPUT_MATRIX"
+#endif
+
+#define BENCH_LOOPBACK_PRIORITY (uint32_t)(1u)
+
+/* TIM3 captures PB0 and PC0 for the loopback bench and for the wake probe */
+#if (BENCHMARK_LOOPBACK == 1u) || (LOW_POWER_WAKE_PROBE == 1u)
+#define KEYS_LOOPBACK_CAPTURE   1u
+#else
+#define KEYS_LOOPBACK_CAPTURE   0u
+#endif
+
+/* 1u moves the LED update out of the key handlers, through key_events */
+#ifndef KEYS_EVENT_QUEUE
+#define KEYS_EVENT_QUEUE    0u
+#endif
+
+#define KEYS_EVENT_SLOTS    (uint32_t)(16u)
+
+#if (KEYS_EVENT_QUEUE == 1u) && (KEYS_INPUT_MODE != KEYS_INPUT_EXTI) && (KEYS_INPUT_MODE != KEYS_INPUT_DEBOUNCED)
+#error "KEYS_EVENT_QUEUE requires KEYS_INPUT_EXTI or KEYS_INPUT_DEBOUNCED"
+#endif
+
+#if (KEYS_EVENT_QUEUE == 1u) && ((LOW_POWER_MODE == LOW_POWER_SLEEP_ON_EXIT) || (LOW_POWER_MODE == LOW_POWER_STOP))
+#error "KEYS_EVENT_QUEUE needs the main loop to run after each wake-up"
+#endif
+
+/* SWO bit rate of the event trace, enabled with TRACE_ITM_ENABLE = 1u */
+#define TRACE_SWO_HZ        (uint32_t)(2000000u)
+
+/* 1u restores the committed LEDs from backup SRAM after a watchdog reset */
+#ifndef WARM_BOOT_ENABLE
+#define WARM_BOOT_ENABLE    0u
+#endif
+
+/* Build a saved LED word belongs to; another build cold boots */
+#define WARM_BOOT_CONFIG    (uint32_t)(((uint32_t)KEYS_INPUT_MODE << 8u) | (uint32_t)CLOCK_PROFILE)
+
 /*==========================================
  *              Private Types
  * ========================================== */
 
+/* Values match the parity bit returned by parity8() */
 typedef enum keyConditions
 {
     EVEN_KEY_PRESSED =      (uint8_t)(0u),
     ODD_KEY_PRESSED  =      (uint8_t)(1u)
 }key_conditions_t;
 
+#if (LOW_POWER_WAKE_PROBE == 1u)
+/**
+ *  @struct  wakeLatency
+ *  @typedef wake_latency_t
+ *  @package STM32_baremetal
+ *
+ *  @brief   Key-edge-to-LED-edge latency, in nanoseconds, for one sleep depth.
+ *
+ *  @details Measured on the pins by TIM3: CH3 latches the PB0 edge and CH1 the
+ *           PC0 edge, through the PC6 jumper, so the wake-up, the exception
+ *           entry and the whole handler up to the ODR change are included. The
+ *           ticks are converted with the timer clock running at the capture,
+ *           which after a Stop wake-up is derived from the 16 MHz HSI.
+ *
+ *           In Stop mode TIM3 is halted along with every clock of the 1.2 V
+ *           domain, so the key edge is latched by the first timer clock after
+ *           the HSI restarts. The regulator and HSI start-up before it are not
+ *           seen by the capture and have to be added from the datasheet
+ *           wake-up time (tWUSTOP) of the selected regulator.
+ */
+typedef struct wakeLatency
+{
+    uint32_t     sleep_mode;    /**< LOW_POWER_MODE the sample was taken with */
+    bench_stat_t nanoseconds;   /**< Latency of every PB0 edge measured */
+}wake_latency_t;
+#endif
+
+#if (BENCHMARK_BUILD == 1u)
+/**
+ *  @struct  benchResults
+ *  @typedef bench_results_t
+ *  @package STM32_baremetal
+ *
+ *  @brief   Cycle statistics of the key-to-LED path, read with the debugger.
+ *
+ *  @details Build once per input mode and compare the records side by side.
+ *           `loop` is a main loop iteration in KEYS_INPUT_POLLING and a whole
+ *           key handler run otherwise. In KEYS_INPUT_CAPTURE, `edge_to_output`
+ *           runs from the first edge of the settled burst, in TIM5 ticks, so it
+ *           includes the 5 ms settle time.
+ */
+typedef struct benchResults
+{
+    uint32_t     input_mode;        /**< KEYS_INPUT_MODE of this build */
+    uint32_t     overhead;          /**< Cost of two back-to-back counter reads */
+    bench_stat_t loop;              /**< Loop iteration or handler run */
+    bench_stat_t parity;            /**< checkKeyConditions(), or the led_rules[] lookup */
+    bench_stat_t output;            /**< LED BSRR store */
+    bench_stat_t edge_to_output;    /**< TIM3 loopback PB0 to PC0, or TIM5 key edge to LED store */
+}bench_results_t;
+#endif
+
+#if (KEYS_EVENT_QUEUE == 1u)
+/**
+ *  @struct  keyEvent
+ *  @typedef key_event_t
+ *  @package STM32_baremetal
+ *
+ *  @brief   One key change, as posted by the key handlers.
+ */
+typedef struct keyEvent
+{
+    uint32_t timestamp;     /**< DWT->CYCCNT when the change was seen */
+    uint16_t keys;          /**< Keys state after the change */
+}key_event_t;
+
+/* Handlers produce, the main loop consumes */
+SPSC_RING_DEFINE(key_events, keyEvents, key_event_t, KEYS_EVENT_SLOTS)
+#endif
+
+#if (WARM_BOOT_ENABLE == 1u)
+/**
+ *  @struct  warmState
+ *  @typedef warm_state_t
+ *  @package STM32_baremetal
+ *
+ *  @brief   Output state kept in backup SRAM across a watchdog reset.
+ */
+typedef struct warmState
+{
+    uint32_t config;        /**< WARM_BOOT_CONFIG of the build that saved it */
+    uint32_t led_word;      /**< Last word committed to GPIOC->BSRR */
+}warm_state_t;
+
+#define WARM_STATE_WORDS    (uint32_t)(sizeof(warm_state_t) / sizeof(uint32_t))
+#endif
+
 /*==========================================
  *         Private Global Variables
  * ========================================== */
 
-static const uint8_t user_output[MAX_KEY_CONDITIONS]
+/* PB0..PB2: user keys, read high when pressed */
+static const gpio_port_config_t keys_pins =
+    GPIO_PORT_GROUP(KEYS_MASK, GPIO_MODE_INPUT, GPIO_PULL_DOWN, GPIO_OTYPE_PUSH_PULL, GPIO_SPEED_LOW, 0u);
+
+/* PC0..PC2: user LEDs */
+static const gpio_port_config_t leds_pins =
+    GPIO_PORT_GROUP(0b111u, GPIO_MODE_OUTPUT, GPIO_PULL_NONE, GPIO_OTYPE_PUSH_PULL, GPIO_SPEED_LOW, 0u);
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_CAPTURE)
+/* PA0..PA2 as TIM5_CH1..CH3 (AF2): user keys, read high when pressed */
+static const gpio_port_config_t capture_keys_pins =
+    GPIO_PORT_GROUP(KEYS_MASK, GPIO_MODE_AF, GPIO_PULL_DOWN, GPIO_OTYPE_PUSH_PULL, GPIO_SPEED_LOW, 2u);
+#endif
+
+#if (KEYS_LOOPBACK_CAPTURE == 1u)
+/* PB0 as TIM3_CH3 (AF2), still read through IDR and EXTI0 */
+static const gpio_port_config_t loopback_key_pin =
+    GPIO_PORT_GROUP(GPIO_PIN(0u), GPIO_MODE_AF, GPIO_PULL_DOWN, GPIO_OTYPE_PUSH_PULL, GPIO_SPEED_LOW, 2u);
+
+/* PC6 as TIM3_CH1 (AF2), jumpered to the even LED on PC0 */
+static const gpio_port_config_t loopback_led_pin =
+    GPIO_PORT_GROUP(GPIO_PIN(6u), GPIO_MODE_AF, GPIO_PULL_NONE, GPIO_OTYPE_PUSH_PULL, GPIO_SPEED_LOW, 2u);
+#endif
+
+#if (KEYS_RULES_TABLE == 1u)
+/* GPIOC->BSRR word of every keys state, expanded from LED_PARITY_RULE */
+static RULES_TABLE_DEFINE(led_rules, KEYS_RULES_INPUTS, LED_PARITY_RULE);
+#else
+/* Precomputed GPIOC->BSRR words: only the LED pins are set or reset */
+static const uint32_t user_output[MAX_KEY_CONDITIONS] =
 {
-    [EVEN_KEY_PRESSED]  = 0b01;
-    [ODD_KEY_PRESSED]   = 0b10;
-}
+    [EVEN_KEY_PRESSED]  = GPIO_BSRR_WORD(LEDS_MASK, 0b01),
+    [ODD_KEY_PRESSED]   = GPIO_BSRR_WORD(LEDS_MASK, 0b10)
+};
+#endif
+
+/* checkKeyConditions() returns the parity bit itself, one entry per value */
+_Static_assert((EVEN_KEY_PRESSED == 0u) && (ODD_KEY_PRESSED == 1u) && (MAX_KEY_CONDITIONS == 2u),
+               "key_conditions_t must match the parity bit");
+
+/* Last LED word stored into GPIOC->BSRR */
+static uint32_t led_committed = OUTPUT_STAGE_NONE;
+
+/* Kept out of static storage optimisations so the debugger can read it */
+output_stats_t led_output_stats __attribute__((used));
+
+#if (WARM_BOOT_ENABLE == 1u)
+/* Survives resets: neither copied nor cleared by the startup code */
+static warm_boot_record_t warm_record WARM_BOOT_SECTION;
+
+/* Reason of the last reset, read with the debugger */
+warm_boot_cause_t warm_boot_cause __attribute__((used));
+#endif
+
+#if (LOW_POWER_WAKE_PROBE == 1u)
+/* Kept out of static storage optimisations so the debugger can read it */
+volatile wake_latency_t wake_latency __attribute__((used)) =
+{
+    .sleep_mode     = LOW_POWER_MODE,
+    .nanoseconds    = BENCH_STAT_INIT
+};
+#endif
+
+#if (BENCHMARK_BUILD == 1u)
+/* Kept out of static storage optimisations so the debugger can read it */
+volatile bench_results_t bench_results __attribute__((used)) =
+{
+    .input_mode     = KEYS_INPUT_MODE,
+    .overhead       = 0u,
+    .loop           = BENCH_STAT_INIT,
+    .parity         = BENCH_STAT_INIT,
+    .output         = BENCH_STAT_INIT,
+    .edge_to_output = BENCH_STAT_INIT
+};
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_DEBOUNCED) || (KEYS_INPUT_MODE == KEYS_INPUT_SCHEDULED) || \
+    (KEYS_INPUT_MODE == KEYS_INPUT_MATRIX)
+/* Written only by the TIM2 handler or the sampling task */
+static debounce_t keys_debounce;
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_SCHEDULED)
+/* Set by the sampling task on a debounced edge, cleared by the parity task */
+static uint8_t keys_changed = 0u;
+
+static void keysSampleTask(void *context);
+
+static void keysParityTask(void *context);
+
+/* Dispatch order: sample first, so a change is seen in the same tick */
+static sched_task_t keys_tasks[] =
+{
+    {
+        .run            = keysSampleTask,
+        .context        = &keys_debounce,
+        .period         = SCHED_SAMPLE_TICKS,
+        .next           = 0u,
+        .budget_cycles  = SCHED_TASK_BUDGET
+    },
+    {
+        .run            = keysParityTask,
+        .context        = &keys_debounce,
+        .period         = SCHED_PARITY_TICKS,
+        .next           = 0u,
+        .budget_cycles  = SCHED_TASK_BUDGET
+    }
+};
+
+/* Kept out of static storage optimisations so the debugger can read it */
+scheduler_t keys_scheduler __attribute__((used));
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_MATRIX)
+/* Kept out of static storage optimisations so the debugger can read it */
+keypad_matrix_t keys_matrix __attribute__((used));
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_CAPTURE)
+/* Kept out of static storage optimisations so the debugger can read it */
+edge_capture_t keys_capture __attribute__((used));
+#endif
+
+#if (KEYS_EVENT_QUEUE == 1u)
+/* Key handlers to main loop */
+static key_events_t key_events;
+#endif
 
 /*==========================================
  *        Private Function Prototypes
  * ========================================== */
 
-static key_conditions_t checkKeyConditions(uint8_t binary_number);
+#if (KEYS_RULES_TABLE == 0u)
+static key_conditions_t checkKeyConditions(uint8_t binary_number) MEM_FAST_CODE_SECTION;
+#endif
+
+static void updateLedOutput(void) MEM_FAST_CODE_SECTION;
+
+static void commitLedOutput(uint8_t user_input) MEM_FAST_CODE_SECTION;
+
+#if (KEYS_EVENT_QUEUE == 1u)
+static void postKeyEvent(uint16_t keys) MEM_FAST_CODE_SECTION;
+
+static void drainKeyEvents(void);
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_EXTI)
+static void configKeysExti(void);
+
+static void configLowPower(void);
+
+static void handleKeyEdge(uint32_t exti_line) MEM_FAST_CODE_SECTION;
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_DEBOUNCED)
+static void configKeysSampling(void);
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_MATRIX)
+static void configKeysMatrix(void);
+
+static void keysMatrixFrame(void *context, uint64_t keys) MEM_FAST_CODE_SECTION;
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_CAPTURE)
+static void configKeysCapture(void);
+
+static void handleCaptureEdges(uint16_t changed);
+#endif
+
+#if (KEYS_LOOPBACK_CAPTURE == 1u)
+static void configBenchLoopback(void);
+#endif
+
+#if (WARM_BOOT_ENABLE == 1u)
+static void restoreWarmOutputs(void);
+
+static void saveWarmOutputs(void);
+#endif
 
 /*==========================================
  *              Main Function
@@ -75,9 +581,19 @@ int main (void)
     /* private variable declaration ------------------------------------------*/
     uint8_t break_condition = 0u;
 
-    uint8_t user_input      = 0u;
+#if (BENCHMARK_BUILD == 1u) && (KEYS_INPUT_MODE == KEYS_INPUT_POLLING)
+    uint32_t loop_stamp     = 0u;
+#endif
+
+#if (WARM_BOOT_ENABLE == 1u)
+    /* After a watchdog reset the LEDs come back before anything else --------*/
+    restoreWarmOutputs();
+#endif
 
-    uint8_t condition_check = 0u;
+    /* Core clock: any outcome leaves SystemCoreClock valid ------------------*/
+    (void)clockConfigInit(&clock_profiles[CLOCK_PROFILE]);
+
+    TRACE_INIT(SystemCoreClock, TRACE_SWO_HZ);
 
     /* Enable Clock for each GPIO --------------------------------------------*/
     RCC->AHB1ENR |= 
@@ -86,62 +602,320 @@ int main (void)
         RCC_AHB1ENR_GPIOCEN      /* GPIOC clock enabled */
     );
 
-    /* Set the user keys inputs ----------------------------------------------*/
-    GPIOB->MODER |= 
-    (
-        (0b00 << 4u) |          /* Mux PB2 for digital input */ 
-        (0b00 << 2u) |          /* Mux PB1 for digital input */
-        (0b00 << 0u)            /* Mux PB0 for digital input */
-    );
+    /* Keys as pulled-down inputs, LEDs as outputs: one write per register */
+    gpioPortApply(GPIOB, &keys_pins);
+    gpioPortApply(GPIOC, &leds_pins);
 
-    /* Set key inputs for pull-down internal resistor ------------------------*/
-    GPIOC->PUPDR |= 
-    (
-        (0b00 << 4u) |          /* Clean pull resistor register at PB2 position */
-        (0b00 << 2u) |          /* Clean pull resistor register at PB1 position */
-        (0b00 << 0u)            /* Clean pull resistor register at PB0 position  */
-    );
+#if (BENCHMARK_BUILD == 1u)
+    /* Start the cycle counter -----------------------------------------------*/
+    bench_results.overhead = benchInit();
+#endif
 
-    GPIOC->PUPDR |= 
-    (
-        (0b01 << 4u) |          /* Set PB2 input for pull-down */
-        (0b01 << 2u) |          /* Set PB1 input for pull-down */
-        (0b01 << 0u)            /* Set PB0 finput or pull-down */
-    );
-    
-    /* Set the user leds outputs ---------------------------------------------*/
-    GPIOC->MODER |= 
-    ( 
-        (0b00 << 4u) |          /* Clean mux register at PC2 position */
-        (0b00 << 2u) |          /* Clean mux register at PC1 position */
-        (0b00 << 0u)            /* Clean mux register at PC0 position */
-    );
+#if (KEYS_LOOPBACK_CAPTURE == 1u)
+    /* Key and LED edges on TIM3, for the loopback bench or the wake probe ---*/
+    configBenchLoopback();
+#endif
 
-    GPIOC->MODER |= 
-    ( 
-        (0b01 << 4u) |          /* Mux PC2 for digital output */
-        (0b01 << 2u) |          /* Mux PC1 for digital output */
-        (0b01 << 0u)            /* Mux PC0 for digital output */
-    );
+#if (KEYS_EVENT_QUEUE == 1u)
+    /* Event queue, timestamped with the cycle counter -----------------------*/
+    keyEventsInit(&key_events);
 
-    /* Main Loop -------------------------------------------------------------*/
+#if (BENCHMARK_BUILD == 0u)
+    /* A benchmark build already started the counter, keep its overhead ------*/
+    (void)benchInit();
+#endif
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_EXTI)
+    /* Route the keys to EXTI0..EXTI2, the LEDs show them from here on ------*/
+    configKeysExti();
+
+    /* Select the sleep depth -----------------------------------------------*/
+    configLowPower();
+
+    /* Main Loop: the LEDs are driven from the EXTI handlers -----------------*/
+    while( !(break_condition) )
+    {
+#if (LOW_POWER_MODE == LOW_POWER_NONE)
+        __NOP();
+#else
+        /* With SLEEPONEXIT set the core never returns here after this WFI */
+        __DSB();
+        __WFI();
+#endif
+
+#if (KEYS_EVENT_QUEUE == 1u)
+        drainKeyEvents();
+#endif
+    }
+#elif (KEYS_INPUT_MODE == KEYS_INPUT_DEBOUNCED)
+    /* Start the debounce engine from the current keys -----------------------*/
+    debounceInit(&keys_debounce, KEYS_MASK, (uint16_t)GPIOB->IDR);
+
+    updateLedOutput();
+
+    /* Sample the keys from TIM2 ---------------------------------------------*/
+    configKeysSampling();
+
+    /* Main Loop: the LEDs are driven from the TIM2 handler ------------------*/
+    while( !(break_condition) )
+    {
+#if (KEYS_EVENT_QUEUE == 1u)
+        drainKeyEvents();
+#else
+        __NOP();
+#endif
+    }
+#elif (KEYS_INPUT_MODE == KEYS_INPUT_SCHEDULED)
+    /* Start the debounce engine from the current keys -----------------------*/
+    debounceInit(&keys_debounce, KEYS_MASK, (uint16_t)GPIOB->IDR);
+
+    updateLedOutput();
+
+    /* Periodic tasks on SysTick ---------------------------------------------*/
+    schedulerInit(&keys_scheduler, keys_tasks, (uint8_t)(sizeof(keys_tasks) / sizeof(keys_tasks[0])));
+
+    (void)schedulerStart(&keys_scheduler, SystemCoreClock, SCHED_TICK_HZ, SCHED_PRIORITY);
+
+    /* Main Loop: run what is due, sleep until the next release --------------*/
+    while( !(break_condition) )
+    {
+        (void)schedulerDispatch(&keys_scheduler);
+
+        schedulerIdle(&keys_scheduler);
+    }
+#elif (KEYS_INPUT_MODE == KEYS_INPUT_MATRIX)
+    /* No key is down before the first scan ----------------------------------*/
+    debounceInit(&keys_debounce, MATRIX_KEYS_MASK, 0u);
+
+    commitLedOutput(0u);
+
+    /* Scan on TIM2, idle on the column EXTI lines ---------------------------*/
+    configKeysMatrix();
+
+    /* Main Loop: the LEDs are driven from the scan handler ------------------*/
+    while( !(break_condition) )
+    {
+        __DSB();
+        __WFI();
+    }
+#elif (KEYS_INPUT_MODE == KEYS_INPUT_CAPTURE)
+    /* Stamp the key edges with TIM5, DMA1 moves them to RAM -----------------*/
+    configKeysCapture();
+
+    commitLedOutput((uint8_t)keys_capture.state);
+
+    /* Main Loop: settle the keys from their stamps --------------------------*/
     while( !(break_condition) )
     {
-        user_input      = (GPIOB->IDR & KEYS_MASK);         
+        handleCaptureEdges(edgeCaptureUpdate(&keys_capture));
+    }
+#else
+    /* Main Loop -------------------------------------------------------------*/
+#if (BENCHMARK_BUILD == 1u)
+    loop_stamp = benchNow();
+#endif
 
-        condition_check = checkKeyConditions(user_input);
+    while( !(break_condition) )
+    {
+        updateLedOutput();
 
-        GPIOC->ODR      = (user_output[condition_check] & LEDS_MASK);
+#if (BENCHMARK_BUILD == 1u)
+        benchRecord(&bench_results.loop, (benchNow() - loop_stamp));
+        loop_stamp = benchNow();
+#endif
     }
+#endif
 
     /* Main return ------------------------------------------------------------*/
     return 0;
 }
 
+/*==========================================
+ *           Interrupt Handlers
+ * ========================================== */
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_EXTI)
+/**
+ *  @fn         EXTI0_IRQHandler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Handles an edge on PB0.
+ */
+MEM_FAST_CODE_SECTION void EXTI0_IRQHandler(void)
+{
+    handleKeyEdge(EXTI_PR_PR0);
+}
+
+/**
+ *  @fn         EXTI1_IRQHandler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Handles an edge on PB1.
+ */
+MEM_FAST_CODE_SECTION void EXTI1_IRQHandler(void)
+{
+    handleKeyEdge(EXTI_PR_PR1);
+}
+
+/**
+ *  @fn         EXTI2_IRQHandler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Handles an edge on PB2.
+ */
+MEM_FAST_CODE_SECTION void EXTI2_IRQHandler(void)
+{
+    handleKeyEdge(EXTI_PR_PR2);
+}
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_DEBOUNCED)
+/**
+ *  @fn         TIM2_IRQHandler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Samples the keys and refreshes the LEDs on a debounced edge.
+ *
+ *  @details    The debounce update costs the same whatever the keys do; the
+ *              LED path only runs when a key was pressed or released.
+ */
+MEM_FAST_CODE_SECTION void TIM2_IRQHandler(void)
+{
+#if (BENCHMARK_BUILD == 1u)
+    uint32_t entry_stamp = benchNow();
+#endif
+
+    uint16_t keys = 0u;
+
+    TIM2->SR = ~TIM_SR_UIF;
+
+    keys = debounceUpdate(&keys_debounce, (uint16_t)GPIOB->IDR);
+
+    if ((keys_debounce.pressed | keys_debounce.released) != 0u)
+    {
+        TRACE_EVENT(TRACE_EVENT_KEY_EDGE, keys);
+
+#if (KEYS_EVENT_QUEUE == 1u)
+        postKeyEvent(keys);
+#else
+        commitLedOutput((uint8_t)keys);
+#endif
+    }
+
+#if (BENCHMARK_BUILD == 1u)
+    benchRecord(&bench_results.loop, (benchNow() - entry_stamp));
+#endif
+}
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_MATRIX)
+/**
+ *  @fn         TIM2_IRQHandler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Reads one keypad row and selects the next.
+ */
+MEM_FAST_CODE_SECTION void TIM2_IRQHandler(void)
+{
+    keypadMatrixTimerIrqHandler(&keys_matrix);
+}
+
+/**
+ *  @fn         EXTI9_5_IRQHandler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Wakes the keypad scan on an edge of columns PB8 and PB9.
+ */
+MEM_FAST_CODE_SECTION void EXTI9_5_IRQHandler(void)
+{
+    keypadMatrixExtiIrqHandler(&keys_matrix);
+}
+
+/**
+ *  @fn         EXTI15_10_IRQHandler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Wakes the keypad scan on an edge of columns PB10 and PB11.
+ */
+MEM_FAST_CODE_SECTION void EXTI15_10_IRQHandler(void)
+{
+    keypadMatrixExtiIrqHandler(&keys_matrix);
+}
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_SCHEDULED)
+/**
+ *  @fn         SysTick_Handler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Advances the scheduler time base.
+ */
+void SysTick_Handler(void)
+{
+    schedulerIrqHandler(&keys_scheduler);
+}
+#endif
+
+#if (KEYS_LOOPBACK_CAPTURE == 1u)
+/**
+ *  @fn         TIM3_IRQHandler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Records the PB0-edge to PC0-edge latency captured by TIM3.
+ *
+ *  @details    CH3 latches the key edge and CH1 the LED edge it caused. Both
+ *              are 16-bit captures of the same counter, so the wrapped
+ *              difference is exact for latencies under 65536 ticks. Reading
+ *              the capture registers clears their flags. An LED edge without
+ *              a new PB0 edge comes from key 1 or 2 and is not recorded.
+ *
+ *              The bench keeps timer ticks; the wake probe converts them with
+ *              the timer clock of the moment, which is the HSI-derived one
+ *              after a Stop wake-up.
+ */
+void TIM3_IRQHandler(void)
+{
+    uint32_t flags    = TIM3->SR;
+    uint16_t led_edge = 0u;
+    uint16_t key_edge = 0u;
+    uint16_t ticks    = 0u;
+
+    if ((flags & TIM_SR_CC1IF) == 0u)
+    {
+        goto end_of_function;
+    }
+
+    led_edge = (uint16_t)TIM3->CCR1;
+
+    if ((flags & TIM_SR_CC3IF) == 0u)
+    {
+        goto end_of_function;
+    }
+
+    key_edge = (uint16_t)TIM3->CCR3;
+    ticks    = (uint16_t)(led_edge - key_edge);
+
+#if (BENCHMARK_LOOPBACK == 1u)
+    benchRecord(&bench_results.edge_to_output, ticks);
+#endif
+
+#if (LOW_POWER_WAKE_PROBE == 1u)
+    /* Every profile, and the HSI after Stop, runs TIM3 at a whole MHz -------*/
+    benchRecord(&wake_latency.nanoseconds,
+                (((uint32_t)ticks * 1000u) / (clockConfigApb1TimerHz() / 1000000u)));
+#endif
+
+end_of_function:
+    return;
+}
+#endif
+
 /*==========================================
  *      Private Function Declaration
  * ========================================== */
 
+#if (KEYS_RULES_TABLE == 0u)
 /**
  *  @fn         checkKeyConditions
  *  @package    STM32_baremetal
@@ -150,14 +924,10 @@ int main (void)
  *
  *  @details    This function evaluates the binary representation of a given number 
  *              to ascertain whether the count of '1' bits is even or odd. 
- *              It performs the following actions:
- * 
- *                  - Initializes a counter to track the number of '1' bits.
- *                  - Iterates through each bit of the binary number.
- *                  - Increments the counter for every '1' bit encountered.
- *                  - Determines if the total count of '1' bits is even or odd.
- *                  - Returns the corresponding key condition based on the parity 
- *                    of the count.
+ *              The parity comes from the constant-time kernel selected by
+ *              `PARITY_KERNEL` in parity.h, so the evaluation takes the same
+ *              number of cycles whatever keys are pressed. The key conditions
+ *              are laid out so that the parity bit is the condition itself.
  *
  *  @param      binary_number [in] : The 8-bit binary number to be evaluated.
  *
@@ -167,19 +937,600 @@ int main (void)
 static key_conditions_t checkKeyConditions(uint8_t binary_number) 
 {
     key_conditions_t ret;
-    
-    uint8_t counter = 0u;
-    
-    while(binary_number) 
+
+    ret = (key_conditions_t)parity8(binary_number);
+
+    return ret;
+}
+#endif
+
+/**
+ *  @fn         updateLedOutput
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Samples the keys and drives the LEDs with the matching output.
+ *
+ *  @details    Shared by the polling loop and the EXTI handlers, so both input
+ *              modes evaluate the keys in exactly the same way.
+ */
+static void updateLedOutput(void)
+{
+    commitLedOutput((uint8_t)(GPIOB->IDR & KEYS_MASK));
+}
+
+/**
+ *  @fn         commitLedOutput
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Drives the LEDs with the output matching a keys state.
+ *
+ *  @details    The LEDs are driven through GPIOC->BSRR in one store, so the
+ *              other pins of port C keep their state and no other driver of the
+ *              port can be overwritten by a read-modify-write. The store is
+ *              skipped when the LEDs already show the wanted output.
+ *
+ *              The BSRR word comes from checkKeyConditions() and user_output[],
+ *              or with KEYS_RULES_TABLE from one led_rules[] load. Either way
+ *              the traced result is the LEDs being set by the word.
+ *
+ *  @param      user_input [in] : Keys state, raw or debounced.
+ */
+static void commitLedOutput(uint8_t user_input)
+{
+    uint32_t led_word = 0u;
+
+#if (BENCHMARK_BUILD == 1u)
+    uint32_t stamp    = benchNow();
+#endif
+
+#if (KEYS_RULES_TABLE == 1u)
+    led_word = rulesLookup(led_rules, KEYS_RULES_INPUTS, user_input);
+#else
+    led_word = user_output[checkKeyConditions(user_input)];
+#endif
+
+#if (BENCHMARK_BUILD == 1u)
+    benchRecord(&bench_results.parity, (benchNow() - stamp));
+#endif
+
+    TRACE_EVENT(TRACE_EVENT_PARITY, (led_word & LEDS_MASK));
+
+#if (BENCHMARK_BUILD == 1u)
+    stamp    = benchNow();
+#endif
+
+    if (outputStageBsrrWrite(&led_output_stats, &led_committed, GPIOC, led_word) != 0u)
+    {
+        TRACE_EVENT(TRACE_EVENT_LED_COMMIT, (led_word & LEDS_MASK));
+
+#if (WARM_BOOT_ENABLE == 1u)
+        saveWarmOutputs();
+#endif
+    }
+
+#if (BENCHMARK_BUILD == 1u)
+    benchRecord(&bench_results.output, (benchNow() - stamp));
+#endif
+}
+
+#if (KEYS_EVENT_QUEUE == 1u)
+/**
+ *  @fn         postKeyEvent
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Queues a key change from a key handler.
+ *
+ *  @details    A full queue drops the change; the main loop catches up on the
+ *              next one, since every event carries the whole keys state.
+ *
+ *  @param      keys [in] : Keys state after the change.
+ */
+static void postKeyEvent(uint16_t keys)
+{
+    key_event_t event =
+    {
+        .timestamp  = benchNow(),
+        .keys       = keys
+    };
+
+    (void)keyEventsPush(&key_events, &event);
+}
+
+/**
+ *  @fn         drainKeyEvents
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Takes every pending key event and shows the newest one.
+ *
+ *  @details    The burst is released from the queue in one batch. Each event
+ *              holds a full keys state, so only the last one reaches the LEDs.
+ */
+static void drainKeyEvents(void)
+{
+    key_event_t batch[KEYS_EVENT_SLOTS];
+
+    uint32_t count = keyEventsDrain(&key_events, batch, KEYS_EVENT_SLOTS);
+
+    if (count != 0u)
+    {
+        commitLedOutput((uint8_t)batch[count - 1u].keys);
+    }
+}
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_EXTI)
+/**
+ *  @fn         configKeysExti
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Routes PB0..PB2 to EXTI0..EXTI2, shows the keys state and
+ *              enables their interrupts.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Enables the SYSCFG clock, needed to write EXTICR.
+ *                  - Selects port B as source of EXTI lines 0, 1 and 2.
+ *                  - Triggers the lines on both rising and falling edges, so
+ *                    pressing and releasing a key are both seen.
+ *                  - Clears any stale pending bit before unmasking the lines.
+ *                  - Sets one NVIC priority for the three lines.
+ *                  - Drives the LEDs from the current keys, then enables the
+ *                    lines in the NVIC.
+ *
+ *              The first LED update runs after the lines are unmasked and
+ *              before their interrupts are enabled. An edge before the unmask
+ *              is seen by that update, and an edge after it stays pending
+ *              until the handler can run, so the LEDs never keep a stale
+ *              state and the output stage is never entered from two
+ *              contexts at once.
+ */
+static void configKeysExti(void)
+{
+    /* SYSCFG clock is required for the EXTI routing -------------------------*/
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+
+    /* Route EXTI0..EXTI2 to PB0..PB2 ----------------------------------------*/
+    SYSCFG->EXTICR[0] = 
+    (
+        (SYSCFG->EXTICR[0] & 
+        ~(
+            SYSCFG_EXTICR1_EXTI0 |      /* Clean EXTI0 source selection */
+            SYSCFG_EXTICR1_EXTI1 |      /* Clean EXTI1 source selection */
+            SYSCFG_EXTICR1_EXTI2        /* Clean EXTI2 source selection */
+        )) |
+        SYSCFG_EXTICR1_EXTI0_PB |       /* EXTI0 sourced from PB0 */
+        SYSCFG_EXTICR1_EXTI1_PB |       /* EXTI1 sourced from PB1 */
+        SYSCFG_EXTICR1_EXTI2_PB         /* EXTI2 sourced from PB2 */
+    );
+
+    /* Trigger on both edges -------------------------------------------------*/
+    EXTI->RTSR |= KEYS_MASK;
+    EXTI->FTSR |= KEYS_MASK;
+
+    /* Drop stale requests, then unmask the lines ----------------------------*/
+    EXTI->PR    = KEYS_MASK;
+    EXTI->IMR  |= KEYS_MASK;
+
+    /* NVIC setup ------------------------------------------------------------*/
+    NVIC_SetPriority(EXTI0_IRQn, KEYS_EXTI_PRIORITY);
+    NVIC_SetPriority(EXTI1_IRQn, KEYS_EXTI_PRIORITY);
+    NVIC_SetPriority(EXTI2_IRQn, KEYS_EXTI_PRIORITY);
+
+    NVIC_ClearPendingIRQ(EXTI0_IRQn);
+    NVIC_ClearPendingIRQ(EXTI1_IRQn);
+    NVIC_ClearPendingIRQ(EXTI2_IRQn);
+
+    /* Show the keys state before the first edge can be handled -------------*/
+    updateLedOutput();
+
+    NVIC_EnableIRQ(EXTI0_IRQn);
+    NVIC_EnableIRQ(EXTI1_IRQn);
+    NVIC_EnableIRQ(EXTI2_IRQn);
+}
+
+/**
+ *  @fn         configLowPower
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Programs the sleep depth.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - For LOW_POWER_SLEEP_ON_EXIT and LOW_POWER_STOP, sets
+ *                    SLEEPONEXIT so the core sleeps again on handler return.
+ *                  - For LOW_POWER_STOP, enables the PWR clock, selects Stop
+ *                    (not Standby) with the configured regulator and sets
+ *                    SLEEPDEEP. The EXTI lines stay active in Stop mode.
+ */
+static void configLowPower(void)
+{
+#if (LOW_POWER_MODE == LOW_POWER_STOP)
+    /* Stop mode, keep the regulator selection explicit ----------------------*/
+    RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+
+#if (LOW_POWER_STOP_LPDS == 1u)
+    PWR->CR = ((PWR->CR & ~PWR_CR_PDDS) | PWR_CR_LPDS);
+#else
+    PWR->CR = (PWR->CR & ~(PWR_CR_PDDS | PWR_CR_LPDS));
+#endif
+
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+#endif
+
+#if (LOW_POWER_MODE == LOW_POWER_SLEEP_ON_EXIT) || (LOW_POWER_MODE == LOW_POWER_STOP)
+    SCB->SCR |= SCB_SCR_SLEEPONEXIT_Msk;
+#endif
+}
+
+/**
+ *  @fn         handleKeyEdge
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Common body of the key EXTI handlers.
+ *
+ *  @details    The pending bit is cleared before the LEDs are refreshed, so an
+ *              edge arriving during the update pends the line again instead of
+ *              being lost. Waking from Stop resumes on the HSI, and the core
+ *              goes back to Stop on return, so the handler stays on it and
+ *              SystemCoreClock only follows it.
+ *
+ *  @param      exti_line [in] : EXTI_PR bit of the line that fired.
+ */
+static void handleKeyEdge(uint32_t exti_line)
+{
+#if (BENCHMARK_BUILD == 1u)
+    uint32_t entry_stamp = benchNow();
+#endif
+
+#if (LOW_POWER_MODE == LOW_POWER_STOP)
+    if ((RCC->CFGR & RCC_CFGR_SWS) == RCC_CFGR_SWS_HSI)
     {
-        counter += (number & 1u);
-        binary_number >>= 1u;
+        SystemCoreClock = CLOCK_HSI_HZ;
     }
-    
-    ret = ((counter % 2u) == 0u || counter == 0u) ? ODD_BINARY : EVEN_BINARY;
-    
+#endif
+
+    EXTI->PR = exti_line;
+
+    TRACE_EVENT(TRACE_EVENT_KEY_EDGE, (GPIOB->IDR & KEYS_MASK));
+
+#if (KEYS_EVENT_QUEUE == 1u)
+    postKeyEvent((uint16_t)(GPIOB->IDR & KEYS_MASK));
+#else
+    updateLedOutput();
+#endif
+
+#if (BENCHMARK_BUILD == 1u)
+    benchRecord(&bench_results.loop, (benchNow() - entry_stamp));
+#endif
+}
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_DEBOUNCED)
+/**
+ *  @fn         configKeysSampling
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Starts TIM2 as the KEYS_SAMPLE_HZ debounce time base.
+ *
+ *  @details    TIM2 counts at KEYS_TIMER_TICK_HZ and raises an update
+ *              interrupt every 1 / KEYS_SAMPLE_HZ seconds. The prescaler is
+ *              taken from the running APB1 timer clock.
+ */
+static void configKeysSampling(void)
+{
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+
+    TIM2->CR1  = 0u;
+    TIM2->PSC  = ((clockConfigApb1TimerHz() / KEYS_TIMER_TICK_HZ) - 1u);
+    TIM2->ARR  = ((KEYS_TIMER_TICK_HZ / KEYS_SAMPLE_HZ) - 1u);
+    TIM2->EGR  = TIM_EGR_UG;
+    TIM2->SR   = ~TIM_SR_UIF;
+    TIM2->DIER = TIM_DIER_UIE;
+
+    NVIC_SetPriority(TIM2_IRQn, KEYS_TIMER_PRIORITY);
+    NVIC_ClearPendingIRQ(TIM2_IRQn);
+    NVIC_EnableIRQ(TIM2_IRQn);
+
+    TIM2->CR1  = (TIM_CR1_ARPE | TIM_CR1_CEN);
+}
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_MATRIX)
+/**
+ *  @fn         configKeysMatrix
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Starts the 4x4 keypad scanner on TIM2 and PB4..PB11.
+ *
+ *  @details    The rows are scanned at MATRIX_SCAN_HZ frames per second from
+ *              the running APB1 timer clock. After MATRIX_IDLE_FRAMES empty
+ *              frames the scan stops until a column falls.
+ */
+static void configKeysMatrix(void)
+{
+    const keypad_matrix_config_t config =
+    {
+        .timer          = TIM2,
+        .timer_irq      = TIM2_IRQn,
+        .priority       = MATRIX_PRIORITY,
+        .timer_clock_hz = clockConfigApb1TimerHz(),
+        .scan_hz        = MATRIX_SCAN_HZ,
+        .row_port       = GPIOB,
+        .row_shift      = MATRIX_ROW_SHIFT,
+        .row_count      = MATRIX_LINES,
+        .col_port       = GPIOB,
+        .col_shift      = MATRIX_COL_SHIFT,
+        .col_count      = MATRIX_LINES,
+        .idle_frames    = MATRIX_IDLE_FRAMES,
+        .on_frame       = keysMatrixFrame,
+        .context        = &keys_debounce
+    };
+
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+
+    (void)keypadMatrixInit(&keys_matrix, &config);
+}
+
+/**
+ *  @fn         keysMatrixFrame
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Debounces a keypad frame and shows its parity on a key edge.
+ *
+ *  @details    Folding the 16-key state onto a byte keeps its parity, so the
+ *              same 8-bit parity path drives the LEDs.
+ *
+ *  @param      context [in] : The `debounce_t` of the keypad.
+ *  @param      keys    [in] : Raw bitmap of the frame.
+ */
+static void keysMatrixFrame(void *context, uint64_t keys)
+{
+    debounce_t *debounce = (debounce_t *)context;
+
+    uint16_t state = debounceUpdate(debounce, (uint16_t)keys);
+
+    if ((debounce->pressed | debounce->released) != 0u)
+    {
+        TRACE_EVENT(TRACE_EVENT_KEY_EDGE, state);
+
+        commitLedOutput((uint8_t)(state ^ (state >> 8u)));
+    }
+}
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_CAPTURE)
+/**
+ *  @fn         configKeysCapture
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Starts the TIM5 edge capture of the keys on PA0..PA2.
+ *
+ *  @details    TIM5 runs unprescaled at the APB1 timer clock, so a stamp is
+ *              exact to two core cycles at 168 MHz. On DMA1 channel 6, CH1 is
+ *              served by stream 2, CH2 by stream 4 and CH3 by stream 0. The
+ *              initial levels are read once, before the first edge.
+ */
+static void configKeysCapture(void)
+{
+    const uint32_t timer_hz = clockConfigApb1TimerHz();
+
+    edge_capture_config_t config =
+    {
+        .timer          = TIM5,
+        .dma            = DMA1,
+        .timer_clock_hz = timer_hz,
+        .tick_hz        = timer_hz,
+        .settle_ticks   = (timer_hz / CAPTURE_SETTLE_HZ),
+        .initial        = 0u,
+        .filter         = CAPTURE_FILTER,
+        .lane_count     = CAPTURE_LANES,
+        .lanes          =
+        {
+            { .stream = DMA1_Stream2, .dma_channel = CAPTURE_DMA_CHANNEL, .tim_channel = 1u },
+            { .stream = DMA1_Stream4, .dma_channel = CAPTURE_DMA_CHANNEL, .tim_channel = 2u },
+            { .stream = DMA1_Stream0, .dma_channel = CAPTURE_DMA_CHANNEL, .tim_channel = 3u }
+        }
+    };
+
+    RCC->AHB1ENR |= (RCC_AHB1ENR_GPIOAEN | RCC_AHB1ENR_DMA1EN);
+    RCC->APB1ENR |= RCC_APB1ENR_TIM5EN;
+
+    gpioPortApply(GPIOA, &capture_keys_pins);
+
+    config.initial = (uint16_t)(GPIOA->IDR & KEYS_MASK);
+
+    (void)edgeCaptureInit(&keys_capture, &config);
+}
+
+/**
+ *  @fn         handleCaptureEdges
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Shows the parity of the settled keys after a press or release.
+ *
+ *  @details    With BENCHMARK_BUILD, the time from the first edge of the
+ *              lowest changed key to the LED store is recorded in TIM5 ticks.
+ *
+ *  @param      changed [in] : Keys whose settled state changed.
+ */
+static void handleCaptureEdges(uint16_t changed)
+{
+    if (changed == 0u)
+    {
+        goto end_of_function;
+    }
+
+    TRACE_EVENT(TRACE_EVENT_KEY_EDGE, keys_capture.state);
+
+    commitLedOutput((uint8_t)keys_capture.state);
+
+#if (BENCHMARK_BUILD == 1u)
+    benchRecord(&bench_results.edge_to_output,
+                edgeCaptureTicks(&keys_capture,
+                                 keys_capture.lanes[__builtin_ctz(changed)].settled_at,
+                                 edgeCaptureNow(&keys_capture)));
+#endif
+
 end_of_function:
-    return ret;
+    return;
+}
+#endif
+
+#if (KEYS_INPUT_MODE == KEYS_INPUT_SCHEDULED)
+/**
+ *  @fn         keysSampleTask
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Scheduler task: feeds one key sample into the debounce engine.
+ *
+ *  @param      context [in] : The `debounce_t` of the keys.
+ */
+static void keysSampleTask(void *context)
+{
+    debounce_t *debounce = (debounce_t *)context;
+
+    (void)debounceUpdate(debounce, (uint16_t)GPIOB->IDR);
+
+    if ((debounce->pressed | debounce->released) != 0u)
+    {
+        keys_changed = 1u;
+
+        TRACE_EVENT(TRACE_EVENT_KEY_EDGE, debounce->state);
+    }
+}
+
+/**
+ *  @fn         keysParityTask
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Scheduler task: shows the parity of the debounced keys.
+ *
+ *  @details    Skips the evaluation and the GPIO store when no key changed
+ *              since the last run.
+ *
+ *  @param      context [in] : The `debounce_t` of the keys.
+ */
+static void keysParityTask(void *context)
+{
+    const debounce_t *debounce = (const debounce_t *)context;
+
+    if (keys_changed != 0u)
+    {
+        keys_changed = 0u;
+
+        commitLedOutput((uint8_t)debounce->state);
+    }
+}
+#endif
+
+#if (KEYS_LOOPBACK_CAPTURE == 1u)
+/**
+ *  @fn         configBenchLoopback
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Captures the PB0 key edges and the PC0 LED edges with TIM3.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Switches PB0 to AF2 (TIM3_CH3). The pin keeps feeding IDR
+ *                    and EXTI0, so every input mode still works.
+ *                  - Switches PC6 to AF2 (TIM3_CH1); PC6 must be jumpered to
+ *                    the even LED on PC0.
+ *                  - Runs TIM3 unprescaled, capturing both edges on CH1 and CH3,
+ *                    and interrupts on the CH1 (LED) capture.
+ */
+static void configBenchLoopback(void)
+{
+    RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;
+
+    /* PB0 as TIM3_CH3, PC6 as TIM3_CH1 --------------------------------------*/
+    gpioPortApply(GPIOB, &loopback_key_pin);
+    gpioPortApply(GPIOC, &loopback_led_pin);
+
+    /* Free-running capture timer --------------------------------------------*/
+    TIM3->CR1   = 0u;
+    TIM3->PSC   = 0u;
+    TIM3->ARR   = 0xFFFFu;
+    TIM3->CCMR1 = TIM_CCMR1_CC1S_0;     /* CC1 input on TI1 */
+    TIM3->CCMR2 = TIM_CCMR2_CC3S_0;     /* CC3 input on TI3 */
+    TIM3->CCER  =
+    (
+        TIM_CCER_CC1E | TIM_CCER_CC1P | TIM_CCER_CC1NP |    /* CH1, both edges */
+        TIM_CCER_CC3E | TIM_CCER_CC3P | TIM_CCER_CC3NP      /* CH3, both edges */
+    );
+    TIM3->EGR   = TIM_EGR_UG;
+    TIM3->SR    = 0u;
+    TIM3->DIER  = TIM_DIER_CC1IE;
+
+    NVIC_SetPriority(TIM3_IRQn, BENCH_LOOPBACK_PRIORITY);
+    NVIC_ClearPendingIRQ(TIM3_IRQn);
+    NVIC_EnableIRQ(TIM3_IRQn);
+
+    TIM3->CR1   = TIM_CR1_CEN;
+}
+#endif
+
+
+#if (WARM_BOOT_ENABLE == 1u)
+/**
+ *  @fn         restoreWarmOutputs
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Drives the LEDs with the saved word after a watchdog reset.
+ *
+ *  @details    Runs first in main(), on the reset clock. The saved word is
+ *              stored into GPIOC->BSRR while the pins are still inputs, then
+ *              the pins become outputs, so they start at the saved levels. The
+ *              word also becomes the committed one, so the first evaluation
+ *              after the full bring-up does not store it again. Any other
+ *              reset, an invalid record or a record of another build leaves
+ *              the LEDs to the normal start-up.
+ */
+static void restoreWarmOutputs(void)
+{
+    warm_state_t state = { 0u, 0u };
+
+    warmBootEnable();
+
+    warm_boot_cause = warmBootResetCause();
+
+    if ((warm_boot_cause != WARM_BOOT_CAUSE_WATCHDOG) ||
+        (warmBootLoad(&warm_record, (uint32_t *)&state, WARM_STATE_WORDS) != WARM_BOOT_OK) ||
+        (state.config != WARM_BOOT_CONFIG))
+    {
+        goto end_of_function;
+    }
+
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOCEN;
+
+    GPIOC->BSRR   = state.led_word;
+    gpioPortApply(GPIOC, &leds_pins);
+
+    led_committed = state.led_word;
+
+end_of_function:
+    return;
+}
+
+/**
+ *  @fn         saveWarmOutputs
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Keeps the committed LED word in backup SRAM.
+ *
+ *  @details    Only runs when the output stage actually stored a new word, in
+ *              the same context, so it costs a few dozen cycles per LED change.
+ */
+static void saveWarmOutputs(void)
+{
+    const warm_state_t state =
+    {
+        .config     = WARM_BOOT_CONFIG,
+        .led_word   = led_committed
+    };
+
+    (void)warmBootSave(&warm_record, (const uint32_t *)&state, WARM_STATE_WORDS);
 }
+#endif
 
 /* end of file */
@@ -0,0 +1,437 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes clock_config
+ *
+ *  @package    clock_config
+ *  @brief      This module provides the clock tree bring-up of the STM32F4:
+ *              PLL, bus prescalers, voltage scaling, flash wait states and the
+ *              ART accelerator, selected through a small set of profiles.
+ *
+ *  @details    Out of reset the core runs from the 16 MHz HSI with no flash
+ *              prefetch and no caches. clockConfigInit() moves it to one of the
+ *              `clock_profiles[]` entries and publishes the resulting HCLK in the
+ *              CMSIS `SystemCoreClock` variable.
+ *
+ *              | Profile                       | SYSCLK  | APB1   | APB2   | VOS     | Wait states |
+ *              |-------------------------------|---------|--------|--------|---------|-------------|
+ *              | CLOCK_PROFILE_MAX_PERFORMANCE | 168 MHz | 42 MHz | 84 MHz | Scale 1 | 5           |
+ *              | CLOCK_PROFILE_84MHZ           | 84 MHz  | 42 MHz | 84 MHz | Scale 2 | 2           |
+ *              | CLOCK_PROFILE_LOW_POWER       | 16 MHz  | 16 MHz | 16 MHz | Scale 2 | 0           |
+ *
+ *              - **Source**: the PLL profiles run from the HSE crystal of
+ *                CLOCK_HSE_HZ. If the crystal does not start within
+ *                CLOCK_READY_TIMEOUT polls, the PLL is fed from the HSI instead,
+ *                the same frequencies are reached and the call reports
+ *                CLOCK_CONFIG_HSE_FALLBACK.
+ *
+ *              - **PLL**: the input is always divided down to CLOCK_PLL_INPUT_HZ
+ *                (2 MHz, the value recommended against jitter), VCO at 336 MHz,
+ *                and PLLQ gives the 48 MHz USB/SDIO clock.
+ *
+ *              - **Sequencing**: the core is parked on the HSI before anything is
+ *                touched, so wait states, voltage scale and PLL can be changed in
+ *                any order, whatever profile was running before. The same call
+ *                therefore restores the clock after a Stop mode wake-up, which
+ *                always resumes on the HSI with the PLL and HSE off.
+ *
+ *              - **ART**: the instruction and data caches are flushed and
+ *                enabled on every profile; prefetch is left off on the low power
+ *                profile, where there are no wait states to hide.
+ *
+ *              Timer kernels run at twice their APB clock whenever the APB
+ *              prescaler is not 1, see clockConfigApb1TimerHz() and
+ *              clockConfigApb2TimerHz().
+ *
+ *  @file       clock_config.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef CLOCK_CONFIG_H_
+#define CLOCK_CONFIG_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def CLOCK_HSE_HZ
+ * @package    clock_config
+ * @brief Frequency of the HSE crystal, 8 MHz on the ST Discovery boards.
+ */
+#ifndef CLOCK_HSE_HZ
+#define CLOCK_HSE_HZ                (uint32_t)(8000000UL)
+#endif
+
+/**
+ * @def CLOCK_HSE_BYPASS
+ * @package    clock_config
+ * @brief 1u when HSE is an external clock signal instead of a crystal.
+ */
+#ifndef CLOCK_HSE_BYPASS
+#define CLOCK_HSE_BYPASS            0u
+#endif
+
+/**
+ * @def CLOCK_HSI_HZ
+ * @package    clock_config
+ * @brief Frequency of the internal RC oscillator.
+ */
+#define CLOCK_HSI_HZ                (uint32_t)(16000000UL)
+
+/**
+ * @def CLOCK_PLL_INPUT_HZ
+ * @package    clock_config
+ * @brief PLL input frequency after the PLLM divider.
+ */
+#define CLOCK_PLL_INPUT_HZ          (uint32_t)(2000000UL)
+
+/**
+ * @def CLOCK_READY_TIMEOUT
+ * @package    clock_config
+ * @brief Polls of a ready flag before an oscillator or the PLL is given up.
+ */
+#define CLOCK_READY_TIMEOUT         (uint32_t)(0x20000UL)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    clockProfile
+ *  @typedef clock_profile_t
+ *  @package    clock_config
+ *
+ *  @brief   Index of a profile in `clock_profiles[]`.
+ */
+typedef enum clockProfile
+{
+    CLOCK_PROFILE_MAX_PERFORMANCE   = (uint8_t)(0u),    /**< 168 MHz from the PLL */
+    CLOCK_PROFILE_84MHZ             = (uint8_t)(1u),    /**< 84 MHz from the PLL */
+    CLOCK_PROFILE_LOW_POWER         = (uint8_t)(2u),    /**< 16 MHz HSI, PLL and HSE off */
+    CLOCK_PROFILE_COUNT             = (uint8_t)(3u)     /**< Number of profiles */
+} clock_profile_t;
+
+/**
+ *  @enum    clockConfigStatus
+ *  @typedef clock_config_status_t
+ *  @package    clock_config
+ *
+ *  @brief   Result of a clock configuration request.
+ */
+typedef enum clockConfigStatus
+{
+    CLOCK_CONFIG_OK             = (uint8_t)(0u),    /**< Profile running as requested */
+    CLOCK_CONFIG_HSE_FALLBACK   = (uint8_t)(1u),    /**< Profile running, PLL fed from HSI */
+    CLOCK_CONFIG_PLL_TIMEOUT    = (uint8_t)(2u)     /**< PLL did not lock, core left on HSI */
+} clock_config_status_t;
+
+/**
+ *  @struct  clockProfileConfig
+ *  @typedef clock_profile_config_t
+ *  @package    clock_config
+ *
+ *  @brief   Register values describing one clock profile.
+ *
+ *  @details `pll_n` at 0 selects the HSI as SYSCLK and leaves the PLL off.
+ */
+typedef struct clockProfileConfig
+{
+    uint32_t hclk_hz;           /**< Resulting SYSCLK and HCLK */
+    uint32_t cfgr_prescalers;   /**< RCC_CFGR HPRE, PPRE1 and PPRE2 fields */
+    uint16_t pll_n;             /**< VCO multiplier, 0 for no PLL */
+    uint8_t  pll_p;             /**< SYSCLK divider: 2, 4, 6 or 8 */
+    uint8_t  pll_q;             /**< 48 MHz domain divider */
+    uint8_t  flash_latency;     /**< FLASH_ACR wait states */
+    uint8_t  vos_scale1;        /**< 1u for voltage scale 1, needed above 144 MHz */
+    uint8_t  prefetch;          /**< 1u to enable the flash prefetch buffer */
+} clock_profile_config_t;
+
+/*==========================================
+ *          Private Global Variables
+ * ========================================== */
+
+/**
+ *  @var        clock_profiles
+ *  @package    clock_config
+ *
+ *  @brief      Register values of every `clock_profile_t`.
+ *
+ *  @details    Wait states are those of the 2.7 V to 3.6 V supply range.
+ */
+const clock_profile_config_t clock_profiles[CLOCK_PROFILE_COUNT] __attribute__((weak, used, aligned(4))) =
+{
+    [CLOCK_PROFILE_MAX_PERFORMANCE] =
+    {
+        .hclk_hz         = 168000000UL,
+        .cfgr_prescalers = (RCC_CFGR_HPRE_DIV1 | RCC_CFGR_PPRE1_DIV4 | RCC_CFGR_PPRE2_DIV2),
+        .pll_n           = 168u,
+        .pll_p           = 2u,
+        .pll_q           = 7u,
+        .flash_latency   = 5u,
+        .vos_scale1      = 1u,
+        .prefetch        = 1u
+    },
+    [CLOCK_PROFILE_84MHZ] =
+    {
+        .hclk_hz         = 84000000UL,
+        .cfgr_prescalers = (RCC_CFGR_HPRE_DIV1 | RCC_CFGR_PPRE1_DIV2 | RCC_CFGR_PPRE2_DIV1),
+        .pll_n           = 168u,
+        .pll_p           = 4u,
+        .pll_q           = 7u,
+        .flash_latency   = 2u,
+        .vos_scale1      = 0u,
+        .prefetch        = 1u
+    },
+    [CLOCK_PROFILE_LOW_POWER] =
+    {
+        .hclk_hz         = CLOCK_HSI_HZ,
+        .cfgr_prescalers = (RCC_CFGR_HPRE_DIV1 | RCC_CFGR_PPRE1_DIV1 | RCC_CFGR_PPRE2_DIV1),
+        .pll_n           = 0u,
+        .pll_p           = 2u,
+        .pll_q           = 2u,
+        .flash_latency   = 0u,
+        .vos_scale1      = 0u,
+        .prefetch        = 0u
+    }
+};
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         clockConfigWaitFlag
+ *  @package    clock_config
+ *
+ *  @brief      Polls an RCC_CR ready flag for at most CLOCK_READY_TIMEOUT reads.
+ *
+ *  @param      flag [in] : RCC_CR flag to wait for.
+ *
+ *  @return     1u if the flag was raised, 0u on timeout.
+ */
+static inline uint8_t clockConfigWaitFlag(uint32_t flag)
+{
+    uint32_t polls = CLOCK_READY_TIMEOUT;
+
+    while (((RCC->CR & flag) == 0u) && (polls > 0u))
+    {
+        polls--;
+    }
+
+    return (uint8_t)((RCC->CR & flag) != 0u);
+}
+
+/**
+ *  @fn         clockConfigSelectSysclk
+ *  @package    clock_config
+ *
+ *  @brief      Switches SYSCLK and waits for the switch to take effect.
+ *
+ *  @param      source [in] : RCC_CFGR_SW_HSI or RCC_CFGR_SW_PLL.
+ */
+static inline void clockConfigSelectSysclk(uint32_t source)
+{
+    RCC->CFGR = ((RCC->CFGR & ~RCC_CFGR_SW) | source);
+
+    while ((RCC->CFGR & RCC_CFGR_SWS) != (source << 2u))
+    {
+        /* Wait for the clock mux */
+    }
+}
+
+/**
+ *  @fn         clockConfigInit
+ *  @package    clock_config
+ *
+ *  @brief      Brings the clock tree up to a profile and updates SystemCoreClock.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Parks SYSCLK on the HSI and stops the PLL.
+ *                  - Programs the wait states and flushes and enables the ART
+ *                    caches, safe at 16 MHz for any wait state count.
+ *                  - Selects the voltage scale, only writable with the PLL off.
+ *                  - Programs the AHB and APB prescalers.
+ *                  - For the PLL profiles, starts HSE (or falls back to HSI),
+ *                    locks the PLL and switches SYSCLK to it; for the HSI
+ *                    profile, stops HSE.
+ *
+ *  @param      profile [in] : Profile to run, e.g. &clock_profiles[CLOCK_PROFILE_84MHZ].
+ *
+ *  @return     CLOCK_CONFIG_OK          : if the profile runs as requested.
+ *              CLOCK_CONFIG_HSE_FALLBACK: if it runs with the PLL fed by HSI.
+ *              CLOCK_CONFIG_PLL_TIMEOUT : if the PLL did not lock, on HSI.
+ */
+static inline clock_config_status_t clockConfigInit(const clock_profile_config_t *profile)
+{
+    clock_config_status_t ret = CLOCK_CONFIG_OK;
+
+    uint32_t pll_source_hz = CLOCK_HSE_HZ;
+    uint32_t pll_source    = RCC_PLLCFGR_PLLSRC_HSE;
+
+    /* Park on HSI, the reference every step below is safe with --------------*/
+    RCC->CR |= RCC_CR_HSION;
+    (void)clockConfigWaitFlag(RCC_CR_HSIRDY);
+
+    clockConfigSelectSysclk(RCC_CFGR_SW_HSI);
+
+    RCC->CR &= ~RCC_CR_PLLON;
+
+    while ((RCC->CR & RCC_CR_PLLRDY) != 0u)
+    {
+        /* Wait for the PLL to stop */
+    }
+
+    SystemCoreClock = CLOCK_HSI_HZ;
+
+    /* Wait states and ART accelerator ---------------------------------------*/
+    FLASH->ACR  = ((uint32_t)profile->flash_latency << FLASH_ACR_LATENCY_Pos);
+    FLASH->ACR |= (FLASH_ACR_ICRST | FLASH_ACR_DCRST);
+    FLASH->ACR &= ~(FLASH_ACR_ICRST | FLASH_ACR_DCRST);
+    FLASH->ACR |= (FLASH_ACR_ICEN | FLASH_ACR_DCEN);
+
+    if (profile->prefetch != 0u)
+    {
+        FLASH->ACR |= FLASH_ACR_PRFTEN;
+    }
+
+    /* Voltage scale ---------------------------------------------------------*/
+    RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+
+    if (profile->vos_scale1 != 0u)
+    {
+        PWR->CR |= PWR_CR_VOS;
+    }
+    else
+    {
+        PWR->CR &= ~PWR_CR_VOS;
+    }
+
+    /* Bus prescalers --------------------------------------------------------*/
+    RCC->CFGR =
+    (
+        (RCC->CFGR & ~(RCC_CFGR_HPRE | RCC_CFGR_PPRE1 | RCC_CFGR_PPRE2)) |
+        profile->cfgr_prescalers
+    );
+
+    if (profile->pll_n == 0u)
+    {
+        RCC->CR &= ~(RCC_CR_HSEON | RCC_CR_HSEBYP);
+
+        SystemCoreClock = profile->hclk_hz;
+
+        goto end_of_function;
+    }
+
+    /* PLL source: HSE, or HSI when the crystal does not start ---------------*/
+#if (CLOCK_HSE_BYPASS == 1u)
+    RCC->CR |= RCC_CR_HSEBYP;
+#endif
+
+    RCC->CR |= RCC_CR_HSEON;
+
+    if (clockConfigWaitFlag(RCC_CR_HSERDY) == 0u)
+    {
+        RCC->CR &= ~(RCC_CR_HSEON | RCC_CR_HSEBYP);
+
+        pll_source_hz = CLOCK_HSI_HZ;
+        pll_source    = 0u;
+
+        ret = CLOCK_CONFIG_HSE_FALLBACK;
+    }
+
+    /* PLL lock --------------------------------------------------------------*/
+    RCC->PLLCFGR =
+    (
+        ((pll_source_hz / CLOCK_PLL_INPUT_HZ) << RCC_PLLCFGR_PLLM_Pos) |
+        ((uint32_t)profile->pll_n << RCC_PLLCFGR_PLLN_Pos)             |
+        ((uint32_t)((profile->pll_p >> 1u) - 1u) << RCC_PLLCFGR_PLLP_Pos) |
+        ((uint32_t)profile->pll_q << RCC_PLLCFGR_PLLQ_Pos)             |
+        pll_source
+    );
+
+    RCC->CR |= RCC_CR_PLLON;
+
+    if (clockConfigWaitFlag(RCC_CR_PLLRDY) == 0u)
+    {
+        RCC->CR &= ~RCC_CR_PLLON;
+
+        ret = CLOCK_CONFIG_PLL_TIMEOUT;
+
+        goto end_of_function;
+    }
+
+    clockConfigSelectSysclk(RCC_CFGR_SW_PLL);
+
+    SystemCoreClock = profile->hclk_hz;
+
+end_of_function:
+    return ret;
+}
+
+/**
+ *  @fn         clockConfigTimerHz
+ *  @package    clock_config
+ *
+ *  @brief      Kernel clock of the timers behind an APB prescaler.
+ *
+ *  @details    Prescaler codes 0..3 divide by 1, codes 4..7 by 2, 4, 8 and 16,
+ *              and a divided APB feeds its timers with twice its clock.
+ *
+ *  @param      ppre [in] : 3-bit PPRE1 or PPRE2 field of RCC_CFGR.
+ *
+ *  @return     Timer kernel frequency, from the current SystemCoreClock.
+ */
+static inline uint32_t clockConfigTimerHz(uint32_t ppre)
+{
+    uint32_t ret = SystemCoreClock;
+
+    if (ppre >= 4u)
+    {
+        ret = (SystemCoreClock >> (ppre - 4u));
+    }
+
+    return ret;
+}
+
+/**
+ *  @fn         clockConfigApb1TimerHz
+ *  @package    clock_config
+ *
+ *  @brief      Kernel clock of TIM2..TIM7 and TIM12..TIM14.
+ *
+ *  @return     Timer kernel frequency in Hz.
+ */
+static inline uint32_t clockConfigApb1TimerHz(void)
+{
+    return clockConfigTimerHz((RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos);
+}
+
+/**
+ *  @fn         clockConfigApb2TimerHz
+ *  @package    clock_config
+ *
+ *  @brief      Kernel clock of TIM1, TIM8 and TIM9..TIM11.
+ *
+ *  @return     Timer kernel frequency in Hz.
+ */
+static inline uint32_t clockConfigApb2TimerHz(void)
+{
+    return clockConfigTimerHz((RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos);
+}
+
+#endif /* CLOCK_CONFIG_H_ */
+/* end of file */
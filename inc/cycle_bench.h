@@ -0,0 +1,168 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes cycle_bench
+ *
+ *  @package    cycle_bench
+ *  @brief      This module provides cycle-accurate timing statistics based on the
+ *              DWT cycle counter of the Cortex-M4.
+ *
+ *  @details    DWT->CYCCNT counts core clock cycles and is read with a single
+ *              load, so timing a code section costs two loads and a subtraction.
+ *              The samples are folded into `bench_stat_t` records that live in RAM
+ *              and are meant to be read back with a debugger while the target
+ *              keeps running.
+ *
+ *              - **Statistics**: every record keeps the last, minimum and maximum
+ *                sample and the number of samples. The mean is refreshed every
+ *                BENCH_MEAN_WINDOW samples with a shift, so recording a sample
+ *                never divides.
+ *
+ *              - **Overhead**: benchInit() returns the cost of two back-to-back
+ *                benchNow() reads, to be subtracted when timing very short
+ *                sections.
+ *
+ *              - **Wrap**: the counter wraps every 2^32 cycles (25 s at 168 MHz);
+ *                unsigned subtraction keeps any section shorter than that exact.
+ *
+ *  @file       cycle_bench.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef CYCLE_BENCH_H_
+#define CYCLE_BENCH_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def BENCH_MEAN_SHIFT
+ * @package    cycle_bench
+ * @brief log2 of the number of samples averaged into `mean`.
+ */
+#define BENCH_MEAN_SHIFT            (uint32_t)(6U)
+
+/**
+ * @def BENCH_MEAN_WINDOW
+ * @package    cycle_bench
+ * @brief Number of samples averaged into `mean`.
+ */
+#define BENCH_MEAN_WINDOW           (uint32_t)(1UL << BENCH_MEAN_SHIFT)
+
+/*==========================================
+ *             Private Macros
+ * ========================================== */
+
+/**
+ * @def BENCH_STAT_INIT
+ * @package    cycle_bench
+ * @brief Initializer of an empty `bench_stat_t`.
+ */
+#define BENCH_STAT_INIT             { .min = UINT32_MAX }
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @struct  benchStat
+ *  @typedef bench_stat_t
+ *  @package    cycle_bench
+ *
+ *  @brief   Cycle statistics of one measured section.
+ */
+typedef struct benchStat
+{
+    uint32_t samples;       /**< Number of samples recorded */
+    uint32_t last;          /**< Most recent sample */
+    uint32_t min;           /**< Shortest sample */
+    uint32_t max;           /**< Longest sample */
+    uint32_t mean;          /**< Mean of the last complete window */
+    uint32_t window_sum;    /**< Sum of the current window */
+} bench_stat_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         benchNow
+ *  @package    cycle_bench
+ *
+ *  @brief      Reads the cycle counter.
+ *
+ *  @return     Current value of DWT->CYCCNT.
+ */
+static inline uint32_t benchNow(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ *  @fn         benchInit
+ *  @package    cycle_bench
+ *
+ *  @brief      Enables the trace block and starts the cycle counter from zero.
+ *
+ *  @return     Cycles measured between two back-to-back benchNow() calls.
+ */
+static inline uint32_t benchInit(void)
+{
+    uint32_t start = 0u;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0u;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    start = benchNow();
+
+    return (benchNow() - start);
+}
+
+/**
+ *  @fn         benchRecord
+ *  @package    cycle_bench
+ *
+ *  @brief      Folds one sample into a statistics record.
+ *
+ *  @param      stat   [in] : Record to be updated.
+ *  @param      cycles [in] : Duration of the measured section.
+ */
+static inline void benchRecord(volatile bench_stat_t *stat, uint32_t cycles)
+{
+    stat->last        = cycles;
+    stat->window_sum += cycles;
+    stat->samples++;
+
+    if (cycles < stat->min)
+    {
+        stat->min = cycles;
+    }
+
+    if (cycles > stat->max)
+    {
+        stat->max = cycles;
+    }
+
+    if ((stat->samples & (BENCH_MEAN_WINDOW - 1u)) == 0u)
+    {
+        stat->mean       = (stat->window_sum >> BENCH_MEAN_SHIFT);
+        stat->window_sum = 0u;
+    }
+}
+
+#endif /* CYCLE_BENCH_H_ */
+/* end of file */
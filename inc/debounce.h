@@ -0,0 +1,143 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes debounce
+ *
+ *  @package    debounce
+ *  @brief      This module provides a bit-sliced debounce engine that filters
+ *              all 16 pins of a GPIO port at once.
+ *
+ *  @details    Each pin owns a 2-bit counter, but the counters are stored
+ *              "vertically": bit n of `count_low` and bit n of `count_high` form
+ *              the counter of pin n. One update therefore advances the 16
+ *              counters together with a handful of bitwise operations, and costs
+ *              the same whether 3 or 16 keys are in use.
+ *
+ *              - **Filter**: a pin changes its stable state only after
+ *                DEBOUNCE_SAMPLES consecutive samples disagree with it; any
+ *                sample that agrees resets its counter.
+ *
+ *              - **Sampling**: debounceUpdate() is meant to run from a periodic
+ *                timer interrupt, e.g. at 1 kHz, which gives a 4 ms filter.
+ *
+ *              - **Outputs**: besides the stable state, every update reports the
+ *                pins that became pressed ('0' -> '1') and released ('1' -> '0')
+ *                in that sample, ready to be forwarded to the application.
+ *
+ *              Cost on a Cortex-M4: 9 data-processing instructions per update,
+ *              plus the loads and stores of the state, independent of the data.
+ *
+ *  @file       debounce.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef DEBOUNCE_H_
+#define DEBOUNCE_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def DEBOUNCE_SAMPLES
+ * @package    debounce
+ * @brief Consecutive disagreeing samples needed to change a stable state.
+ *
+ * @details Set by the 2-bit width of the vertical counters.
+ */
+#define DEBOUNCE_SAMPLES            (uint8_t)(4U)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @struct  debounce
+ *  @typedef debounce_t
+ *  @package    debounce
+ *
+ *  @brief   State of the 16 vertical counters of one port.
+ */
+typedef struct debounce
+{
+    uint16_t mask;          /**< Pins being debounced, other pins read as '0' */
+    uint16_t state;         /**< Debounced level of every pin */
+    uint16_t count_low;     /**< Bit 0 of every pin counter */
+    uint16_t count_high;    /**< Bit 1 of every pin counter */
+    uint16_t pressed;       /**< Pins that went '0' -> '1' on the last update */
+    uint16_t released;      /**< Pins that went '1' -> '0' on the last update */
+} debounce_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         debounceInit
+ *  @package    debounce
+ *
+ *  @brief      Starts the engine from a known level.
+ *
+ *  @param      debounce [out] : Engine to be initialised.
+ *  @param      mask     [in]  : Pins to be debounced.
+ *  @param      initial  [in]  : Level taken as stable, usually a first IDR read.
+ */
+static inline void debounceInit(debounce_t *debounce, uint16_t mask, uint16_t initial)
+{
+    debounce->mask       = mask;
+    debounce->state      = (uint16_t)(initial & mask);
+    debounce->count_low  = 0u;
+    debounce->count_high = 0u;
+    debounce->pressed    = 0u;
+    debounce->released   = 0u;
+}
+
+/**
+ *  @fn         debounceUpdate
+ *  @package    debounce
+ *
+ *  @brief      Feeds one sample of the port into the engine.
+ *
+ *  @details    It performs the following actions, for all pins in parallel:
+ *
+ *                  - Flags the pins whose sample differs from the stable state.
+ *                  - Clears the counters of the pins that agree, and counts up
+ *                    the others (count_low toggles, count_high takes the carry).
+ *                  - Toggles the pins whose counter wrapped back to zero while
+ *                    still disagreeing, i.e. after DEBOUNCE_SAMPLES samples.
+ *                  - Splits the toggled pins into pressed and released masks.
+ *
+ *  @param      debounce [in] : Engine to be updated.
+ *  @param      sample   [in] : Raw level of the port, e.g. GPIOx->IDR.
+ *
+ *  @return     The debounced level of the port.
+ */
+static inline uint16_t debounceUpdate(debounce_t *debounce, uint16_t sample)
+{
+    uint16_t delta  = (uint16_t)((sample & debounce->mask) ^ debounce->state);
+
+    uint16_t toggle = 0u;
+
+    debounce->count_high = (uint16_t)((debounce->count_high ^ debounce->count_low) & delta);
+    debounce->count_low  = (uint16_t)(~debounce->count_low & delta);
+
+    toggle = (uint16_t)(delta & ~(debounce->count_low | debounce->count_high));
+
+    debounce->state    ^= toggle;
+    debounce->pressed   = (uint16_t)(toggle & debounce->state);
+    debounce->released  = (uint16_t)(toggle & ~debounce->state);
+
+    return debounce->state;
+}
+
+#endif /* DEBOUNCE_H_ */
+/* end of file */
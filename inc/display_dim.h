@@ -0,0 +1,422 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes display_dim
+ *
+ *  @package    display_dim
+ *  @brief      This module provides per-digit, gamma-corrected brightness for
+ *              the DMA-refreshed 7-segment display, with no CPU work per scan.
+ *
+ *  @details    Builds on `display_dma.h`: the timer update still streams one
+ *              BSRR word per digit into the port. Two compare channels of the
+ *              same timer add the dimming, both served by DMA2:
+ *
+ *              - **Blanking (CC1)**: at CNT == CCR1 a stream writes one fixed
+ *                BSRR word that turns every digit enable off and leaves the
+ *                segment lines alone. CCR1 is therefore the on-time of the
+ *                digit lit in the current period. A CCR1 above ARR never
+ *                matches, so full brightness costs no blanking beat.
+ *
+ *              - **Per-digit compare (CC2)**: at CNT == 1 a second stream walks
+ *                `duty[]` and writes the next on-time into CCR1. CCR1 preload
+ *                is on, so the value only takes effect at the next update,
+ *                which is exactly when the next digit is lit: `duty[i]` is the
+ *                on-time of digit i.
+ *
+ *              - **Gamma**: levels 0..255 go through `display_gamma`, a Q16
+ *                table of (level / 255)^2.2, so equal level steps look like
+ *                equal brightness steps instead of crowding at the top.
+ *
+ *              - **Segment-count compensation**: with one driver per digit
+ *                the lit segments share the digit current, so a "1" glows
+ *                brighter than an "8" at the same duty. When enabled, the duty
+ *                is scaled by `display_segment_gain[n]` with n the number of
+ *                lit segments, counted with popcountLut8().
+ *
+ *              The CPU only recomputes one `duty` word when a level or a code
+ *              changes, in displayDimSetLevel() and displayDimWrite().
+ *
+ *              Only TIM1 and TIM8 can pace DMA2, and their streams are fixed:
+ *
+ *              | Timer | UP          | CH1 (blanking)        | CH2 (compare) |
+ *              |-------|-------------|-----------------------|---------------|
+ *              | TIM1  | S5, ch 6    | S1 or S3, ch 6        | S2, ch 6      |
+ *              | TIM8  | S1, ch 7    | S2, ch 7              | S3, ch 7      |
+ *
+ *              The timer, DMA2 and GPIO clocks have to be enabled by the caller
+ *              before displayDimInit() runs.
+ *
+ *  @file       display_dim.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef DISPLAY_DIM_H_
+#define DISPLAY_DIM_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+#include "parity.h"
+#include "display_segments.h"
+#include "display_mux.h"
+#include "display_dma.h"
+#include "mem_placement.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def DISPLAY_DIM_TIM1_CC_CHANNEL
+ * @package    display_dim
+ * @brief DMA2 channel of the TIM1 CH1/CH2 requests (streams 1/3 and 2).
+ */
+#define DISPLAY_DIM_TIM1_CC_CHANNEL (uint32_t)(6U)
+
+/**
+ * @def DISPLAY_DIM_TIM8_CC_CHANNEL
+ * @package    display_dim
+ * @brief DMA2 channel of the TIM8 CH1/CH2 requests (streams 2 and 3).
+ */
+#define DISPLAY_DIM_TIM8_CC_CHANNEL (uint32_t)(7U)
+
+/**
+ * @def DISPLAY_DIM_LEVELS
+ * @package    display_dim
+ * @brief Number of brightness levels, 0 is off and 255 is full on.
+ */
+#define DISPLAY_DIM_LEVELS          (uint32_t)(256U)
+
+/**
+ * @def DISPLAY_DIM_LEVEL_MAX
+ * @package    display_dim
+ * @brief Full brightness level, the default of every digit.
+ */
+#define DISPLAY_DIM_LEVEL_MAX       (uint8_t)(255U)
+
+/**
+ * @def DISPLAY_DIM_Q16_ONE
+ * @package    display_dim
+ * @brief Largest Q16 duty, treated as 100 %.
+ */
+#define DISPLAY_DIM_Q16_ONE         (uint32_t)(0xFFFFU)
+
+/**
+ * @def DISPLAY_DIM_COMPARE_TICK
+ * @package    display_dim
+ * @brief CCR2 value: counter tick at which the next on-time is preloaded.
+ */
+#define DISPLAY_DIM_COMPARE_TICK    (uint32_t)(1U)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @struct  displayDimConfig
+ *  @typedef display_dim_config_t
+ *  @package    display_dim
+ *
+ *  @brief   DMA-refreshed display plus the streams of the dimming channels.
+ *
+ *  @details `scan.layout.timer` must be TIM1 or TIM8, and at least 3 ticks per
+ *           digit period are needed to place CC2 between the update and CC1.
+ */
+typedef struct displayDimConfig
+{
+    display_dma_config_t scan;                  /**< Layout and update stream */
+    DMA_Stream_TypeDef  *blank_stream;          /**< Stream serving the CH1 request */
+    uint32_t             blank_channel;         /**< Request channel of that stream */
+    DMA_Stream_TypeDef  *duty_stream;           /**< Stream serving the CH2 request */
+    uint32_t             duty_channel;          /**< Request channel of that stream */
+    uint8_t              segment_compensation;  /**< 1u to scale duty by lit segments */
+} display_dim_config_t;
+
+/**
+ *  @struct  displayDim
+ *  @typedef display_dim_t
+ *  @package    display_dim
+ *
+ *  @brief   Runtime state of a dimmed display.
+ */
+typedef struct displayDim
+{
+    display_dma_t        display;                           /**< Scan state and BSRR words */
+    uint32_t             period_ticks;                      /**< Timer ticks per digit, ARR + 1 */
+    uint8_t              compensate;                        /**< Segment-count compensation on */
+    uint8_t              level[DISPLAY_MUX_MAX_DIGITS];     /**< Brightness level per digit */
+    volatile uint32_t    blank_word;                        /**< BSRR word of the CH1 stream */
+    volatile uint32_t    duty[DISPLAY_MUX_MAX_DIGITS];      /**< CCR1 per digit, CH2 stream source */
+} display_dim_t;
+
+/*==========================================
+ *         Private Global Variables
+ * ========================================== */
+
+/**
+ *  @var display_gamma
+ *  @package    display_dim
+ *
+ *  @brief  Q16 duty of every brightness level, round((level / 255)^2.2 * 65535).
+ */
+const uint16_t display_gamma[DISPLAY_DIM_LEVELS] __attribute__((weak, used, aligned(4))) MEM_TABLE_SECTION =
+{
+    0x0000U, 0x0000U, 0x0002U, 0x0004U, 0x0007U, 0x000BU, 0x0011U, 0x0018U,
+    0x0020U, 0x002AU, 0x0035U, 0x0041U, 0x004FU, 0x005EU, 0x006FU, 0x0081U,
+    0x0094U, 0x00A9U, 0x00C0U, 0x00D8U, 0x00F2U, 0x010EU, 0x012BU, 0x014AU,
+    0x016AU, 0x018CU, 0x01B0U, 0x01D5U, 0x01FCU, 0x0225U, 0x024FU, 0x027BU,
+    0x02A9U, 0x02D9U, 0x030BU, 0x033EU, 0x0373U, 0x03AAU, 0x03E3U, 0x041DU,
+    0x0459U, 0x0497U, 0x04D7U, 0x0519U, 0x055DU, 0x05A3U, 0x05EAU, 0x0633U,
+    0x067FU, 0x06CCU, 0x071BU, 0x076CU, 0x07BFU, 0x0814U, 0x086BU, 0x08C3U,
+    0x091EU, 0x097BU, 0x09D9U, 0x0A3AU, 0x0A9DU, 0x0B01U, 0x0B68U, 0x0BD0U,
+    0x0C3BU, 0x0CA8U, 0x0D16U, 0x0D87U, 0x0DFAU, 0x0E6EU, 0x0EE5U, 0x0F5EU,
+    0x0FD9U, 0x1056U, 0x10D5U, 0x1156U, 0x11DAU, 0x125FU, 0x12E6U, 0x1370U,
+    0x13FBU, 0x1489U, 0x1519U, 0x15ABU, 0x163FU, 0x16D5U, 0x176EU, 0x1808U,
+    0x18A5U, 0x1944U, 0x19E5U, 0x1A88U, 0x1B2DU, 0x1BD4U, 0x1C7EU, 0x1D2AU,
+    0x1DD8U, 0x1E88U, 0x1F3AU, 0x1FEFU, 0x20A6U, 0x215FU, 0x221AU, 0x22D7U,
+    0x2397U, 0x2459U, 0x251DU, 0x25E3U, 0x26ACU, 0x2776U, 0x2843U, 0x2913U,
+    0x29E4U, 0x2AB8U, 0x2B8EU, 0x2C66U, 0x2D41U, 0x2E1EU, 0x2EFDU, 0x2FDEU,
+    0x30C2U, 0x31A8U, 0x3290U, 0x337BU, 0x3468U, 0x3557U, 0x3648U, 0x373CU,
+    0x3832U, 0x392BU, 0x3A25U, 0x3B22U, 0x3C22U, 0x3D24U, 0x3E28U, 0x3F2EU,
+    0x4037U, 0x4142U, 0x424FU, 0x435FU, 0x4471U, 0x4586U, 0x469DU, 0x47B6U,
+    0x48D2U, 0x49F0U, 0x4B10U, 0x4C33U, 0x4D58U, 0x4E7FU, 0x4FA9U, 0x50D6U,
+    0x5204U, 0x5335U, 0x5469U, 0x559FU, 0x56D7U, 0x5812U, 0x594FU, 0x5A8EU,
+    0x5BD0U, 0x5D15U, 0x5E5CU, 0x5FA5U, 0x60F1U, 0x623FU, 0x638FU, 0x64E2U,
+    0x6638U, 0x6790U, 0x68EAU, 0x6A47U, 0x6BA6U, 0x6D08U, 0x6E6CU, 0x6FD3U,
+    0x713CU, 0x72A7U, 0x7415U, 0x7586U, 0x76F9U, 0x786EU, 0x79E6U, 0x7B61U,
+    0x7CDEU, 0x7E5DU, 0x7FDFU, 0x8164U, 0x82EAU, 0x8474U, 0x8600U, 0x878EU,
+    0x891FU, 0x8AB3U, 0x8C49U, 0x8DE1U, 0x8F7CU, 0x911AU, 0x92BAU, 0x945DU,
+    0x9602U, 0x97A9U, 0x9954U, 0x9B00U, 0x9CB0U, 0x9E62U, 0xA016U, 0xA1CDU,
+    0xA386U, 0xA542U, 0xA701U, 0xA8C2U, 0xAA86U, 0xAC4CU, 0xAE15U, 0xAFE1U,
+    0xB1AFU, 0xB37FU, 0xB552U, 0xB728U, 0xB900U, 0xBADBU, 0xBCB9U, 0xBE99U,
+    0xC07BU, 0xC261U, 0xC449U, 0xC633U, 0xC820U, 0xCA10U, 0xCC02U, 0xCDF7U,
+    0xCFEEU, 0xD1E8U, 0xD3E5U, 0xD5E4U, 0xD7E6U, 0xD9EBU, 0xDBF2U, 0xDDFCU,
+    0xE008U, 0xE217U, 0xE429U, 0xE63DU, 0xE854U, 0xEA6EU, 0xEC8AU, 0xEEA9U,
+    0xF0CAU, 0xF2EEU, 0xF515U, 0xF73FU, 0xF96BU, 0xFB9AU, 0xFDCBU, 0xFFFFU,
+};
+
+/**
+ *  @var display_segment_gain
+ *  @package    display_dim
+ *
+ *  @brief  Q8 duty scale per number of lit segments, (8 + n) / 16.
+ *
+ *  @details
+ *  A full "8." keeps its duty, a single lit segment gets 56 % of it. Boards
+ *  with one resistor per segment can override the table with all 256s.
+ */
+const uint16_t display_segment_gain[DISPLAY_MUX_SEGMENT_LINES + 1u] __attribute__((weak, used, aligned(4))) MEM_TABLE_SECTION =
+{
+    128U, 144U, 160U, 176U, 192U, 208U, 224U, 240U, 256U
+};
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         displayDimDuty
+ *  @package    display_dim
+ *
+ *  @brief      Computes the CCR1 on-time of one digit.
+ *
+ *  @details    The duty is `gamma[level] * gain[lit segments]`, scaled to the
+ *              digit period. A full duty returns the period itself, which is
+ *              above ARR and never matches; any other lit level gets at least
+ *              one tick.
+ *
+ *  @param      dim   [in] : Driver instance.
+ *  @param      digit [in] : Digit position.
+ *
+ *  @return     The CCR1 value of that digit.
+ */
+static inline uint32_t displayDimDuty(const display_dim_t *dim, uint8_t digit)
+{
+    uint32_t q16   = display_gamma[dim->level[digit]];
+    uint32_t ticks = 0u;
+
+    if (dim->compensate != 0u)
+    {
+        uint8_t lit = popcountLut8(DISPLAY_FONT_CODE(dim->display.mux.back->code[digit]));
+
+        q16 = ((q16 * display_segment_gain[lit]) >> 8u);
+    }
+
+    if (q16 >= DISPLAY_DIM_Q16_ONE)
+    {
+        ticks = dim->period_ticks;
+        goto end_of_function;
+    }
+
+    ticks = ((q16 * dim->period_ticks) >> 16u);
+
+    if (ticks == 0u)
+    {
+        ticks = 1u;
+    }
+
+end_of_function:
+    return ticks;
+}
+
+/**
+ *  @fn         displayDimWrite
+ *  @package    display_dim
+ *
+ *  @brief      Sets the segment code shown on one digit.
+ *
+ *  @details    Same as displayDmaWrite(), plus the duty refresh when the lit
+ *              segment count is part of it. A level 0 digit stays blank.
+ *
+ *  @param      dim   [in] : Driver instance.
+ *  @param      digit [in] : Digit position, 0 is the first digit enable pin.
+ *  @param      code  [in] : Segment code, e.g. display_number[DISPLAY_NUM_7].
+ */
+static inline void displayDimWrite(display_dim_t *dim, uint8_t digit, uint8_t code)
+{
+    dim->display.mux.back->code[digit] = code;
+
+    if (dim->level[digit] != 0u)
+    {
+        dim->display.bsrr[digit] = displayMuxDigitWord(&dim->display.mux, digit, code);
+    }
+
+    if (dim->compensate != 0u)
+    {
+        dim->duty[digit] = displayDimDuty(dim, digit);
+    }
+}
+
+/**
+ *  @fn         displayDimSetLevel
+ *  @package    display_dim
+ *
+ *  @brief      Sets the brightness of one digit.
+ *
+ *  @details    Level 0 streams blank segments for the digit, any other level
+ *              restores its code and stores the new on-time in `duty`.
+ *
+ *  @param      dim   [in] : Driver instance.
+ *  @param      digit [in] : Digit position.
+ *  @param      level [in] : Brightness, 0 (off) to DISPLAY_DIM_LEVEL_MAX.
+ */
+static inline void displayDimSetLevel(display_dim_t *dim, uint8_t digit, uint8_t level)
+{
+    uint8_t code = (level != 0u) ? dim->display.mux.back->code[digit] : DISPLAY_CODE_BLANK;
+
+    dim->level[digit]        = level;
+    dim->display.bsrr[digit] = displayMuxDigitWord(&dim->display.mux, digit, code);
+    dim->duty[digit]         = displayDimDuty(dim, digit);
+}
+
+/**
+ *  @fn         displayDimInit
+ *  @package    display_dim
+ *
+ *  @brief      Configures the port, the timer and the three DMA streams.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Runs displayMuxSetup() and checks the timer period; the
+ *                    layout must not be double buffered, `bsrr` is written in
+ *                    place.
+ *                  - Blanks every digit at full level and builds the blanking
+ *                    word from the digit enables.
+ *                  - Starts the CH1 stream (one word to BSRR), the CH2 stream
+ *                    (`duty[]` to CCR1) and the update stream (`bsrr[]` to
+ *                    BSRR).
+ *                  - Sets CCR1 preload, CCR2 to the compare tick, enables the
+ *                    three DMA requests and starts the timer.
+ *
+ *              The compare channels stay frozen, no timer pin is driven.
+ *
+ *  @param      dim    [out] : Driver instance to be initialised.
+ *  @param      config [in]  : Layout, DMA resources and compensation flag.
+ *
+ *  @return     DISPLAY_MUX_OK     : if the display is being refreshed.
+ *              DISPLAY_MUX_INVALID: if the configuration can not be honoured.
+ */
+static inline display_mux_status_t displayDimInit(display_dim_t *dim,
+                                                  const display_dim_config_t *config)
+{
+    const display_mux_config_t *layout = &config->scan.layout;
+
+    display_mux_status_t ret = displayMuxSetup(&dim->display.mux, layout);
+
+    uint32_t digit_mask = 0u;
+    uint8_t  index      = 0u;
+
+    if (ret != DISPLAY_MUX_OK)
+    {
+        goto end_of_function;
+    }
+
+    dim->period_ticks = (layout->timer->ARR + 1u);
+
+    if (layout->double_buffer != 0u)
+    {
+        ret = DISPLAY_MUX_INVALID;
+        goto end_of_function;
+    }
+
+    if (dim->period_ticks <= (DISPLAY_DIM_COMPARE_TICK + 1u))
+    {
+        ret = DISPLAY_MUX_INVALID;
+        goto end_of_function;
+    }
+
+    /* Frame buffers ---------------------------------------------------------*/
+    dim->display.dma    = config->scan.dma;
+    dim->display.stream = config->scan.stream;
+    dim->display.swap   = DISPLAY_SWAP_IDLE;
+    dim->display.front  = &dim->display.bsrr[0];
+    dim->display.back   = &dim->display.bsrr[0];
+    dim->compensate     = config->segment_compensation;
+
+    digit_mask = ((dim->display.mux.digit_word[0] | (dim->display.mux.digit_word[0] >> 16u)) & 0xFFFFu);
+
+    dim->blank_word = (layout->digit_active_low != 0u) ? digit_mask :
+                      (digit_mask << GPIO_BSRR_RESET_SHIFT);
+
+    for (index = 0u; index < DISPLAY_MUX_MAX_DIGITS; index++)
+    {
+        dim->level[index]        = DISPLAY_DIM_LEVEL_MAX;
+        dim->display.bsrr[index] = displayMuxDigitWord(&dim->display.mux, index, DISPLAY_CODE_BLANK);
+        dim->duty[index]         = displayDimDuty(dim, index);
+    }
+
+    /* Compare channels ------------------------------------------------------*/
+    layout->timer->CCMR1 = TIM_CCMR1_OC1PE;
+    layout->timer->CCR1  = dim->period_ticks;         /* Nothing to blank before the first digit */
+    layout->timer->CCR2  = DISPLAY_DIM_COMPARE_TICK;
+    layout->timer->EGR   = TIM_EGR_UG;
+    layout->timer->SR    = 0u;
+
+    /* Streams: blanking, next on-time, digit words --------------------------*/
+    displayDmaStreamStart(config->scan.dma, config->blank_stream, config->blank_channel,
+                          &dim->blank_word, &layout->port->BSRR, 1u, 0u);
+
+    displayDmaStreamStart(config->scan.dma, config->duty_stream, config->duty_channel,
+                          &dim->duty[0], &layout->timer->CCR1, layout->digit_count, 1u);
+
+    displayDmaStreamStart(config->scan.dma, config->scan.stream, config->scan.channel,
+                          &dim->display.bsrr[0], &layout->port->BSRR, layout->digit_count, 1u);
+
+    /* Update and compare DMA requests ---------------------------------------*/
+    layout->timer->DIER  = (TIM_DIER_UDE | TIM_DIER_CC1DE | TIM_DIER_CC2DE);
+    layout->timer->CR1   = (TIM_CR1_ARPE | TIM_CR1_CEN);
+
+end_of_function:
+    return ret;
+}
+
+#endif /* DISPLAY_DIM_H_ */
+/* end of file */
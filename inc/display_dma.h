@@ -0,0 +1,479 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes display_dma
+ *
+ *  @package    display_dma
+ *  @brief      This module provides a zero-CPU refresh backend for multiplexed
+ *              7-segment displays, streaming BSRR words to the port with DMA2.
+ *
+ *  @details    This backend shares the wiring, the timing and the pin setup of
+ *              `display_mux.h`, but no interrupt runs during the scan. Each
+ *              frame is a circular buffer of one 32-bit BSRR word per digit,
+ *              built with displayMuxDigitWord() from the `display_segments.h`
+ *              codes. The timer update event requests one DMA2 beat per period,
+ *              and every beat writes the next word straight into GPIOx->BSRR.
+ *
+ *              - **Timers**: only DMA2 can reach the AHB1 GPIO ports, so the
+ *                update request has to come from TIM1 (DMA2 stream 5 channel 6)
+ *                or TIM8 (DMA2 stream 1 channel 7).
+ *
+ *              - **Updates**: the CPU only writes the buffer when the content
+ *                changes. A word is stored in one bus write, so the DMA always
+ *                reads either the old or the new digit, never a mix of both.
+ *
+ *              - **Jitter**: the beats are paced by the timer in hardware, so
+ *                the refresh does not move with interrupt latency or CPU load.
+ *
+ *              - **Double buffering**: with `layout.double_buffer` set, the
+ *                stream runs in double-buffer mode (DBM) with M0AR and M1AR
+ *                both on the front frame, and raises its transfer-complete
+ *                interrupt once per frame. After displayDmaPresent(), that
+ *                interrupt writes the back frame into the idle address register,
+ *                so the hardware switches to it at the next frame boundary. One
+ *                frame later the old front is no longer read; it gets a copy of
+ *                the new front and becomes the back frame. The application
+ *                calls displayDmaFrameIrqHandler() from the stream vector.
+ *
+ *              The timer, DMA2 and GPIO clocks have to be enabled by the caller
+ *              before displayDmaInit() runs.
+ *
+ *  @file       display_dma.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef DISPLAY_DMA_H_
+#define DISPLAY_DMA_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+#include "display_mux.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def DISPLAY_DMA_TIM1_UP_CHANNEL
+ * @package    display_dma
+ * @brief DMA2 channel of the TIM1 update request, served by stream 5.
+ */
+#define DISPLAY_DMA_TIM1_UP_CHANNEL (uint32_t)(6U)
+
+/**
+ * @def DISPLAY_DMA_TIM8_UP_CHANNEL
+ * @package    display_dma
+ * @brief DMA2 channel of the TIM8 update request, served by stream 1.
+ */
+#define DISPLAY_DMA_TIM8_UP_CHANNEL (uint32_t)(7U)
+
+/**
+ * @def DISPLAY_DMA_STREAM_FLAGS
+ * @package    display_dma
+ * @brief Event flags of one stream (FEIF, DMEIF, TEIF, HTIF, TCIF) at offset 0.
+ */
+#define DISPLAY_DMA_STREAM_FLAGS    (uint32_t)(0x3DU)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @struct  displayDmaConfig
+ *  @typedef display_dma_config_t
+ *  @package    display_dma
+ *
+ *  @brief   Display layout plus the DMA resources streaming it.
+ *
+ *  @details `layout.timer_irq` and `layout.timer_priority` are not used, the
+ *           scan raises no interrupt.
+ */
+typedef struct displayDmaConfig
+{
+    display_mux_config_t layout;            /**< Wiring and refresh rate */
+    DMA_TypeDef         *dma;               /**< DMA controller, must be DMA2 */
+    DMA_Stream_TypeDef  *stream;            /**< Stream serving the timer update request */
+    uint32_t             channel;           /**< Request channel of that stream */
+    IRQn_Type            stream_irq;        /**< Interrupt of that stream, double buffering only */
+    uint32_t             stream_priority;   /**< NVIC priority of the frame interrupt */
+} display_dma_config_t;
+
+/**
+ *  @struct  displayDma
+ *  @typedef display_dma_t
+ *  @package    display_dma
+ *
+ *  @brief   Runtime state of a DMA-refreshed display.
+ *
+ *  @details `mux.back` holds the codes last written. Without double buffering,
+ *           `front` and `back` both point at `bsrr`.
+ */
+typedef struct displayDma
+{
+    display_mux_t        mux;                               /**< Layout and digit enables */
+    DMA_TypeDef         *dma;                               /**< Controller of the stream */
+    DMA_Stream_TypeDef  *stream;                            /**< Running stream */
+    volatile uint32_t   *volatile front;                    /**< Frame read by the stream */
+    volatile uint32_t   *volatile back;                     /**< Frame written by displayDmaWrite() */
+    volatile uint8_t     swap;                              /**< display_swap_t of the back frame */
+    volatile uint32_t    bsrr[DISPLAY_MUX_MAX_DIGITS];      /**< Circular DMA source */
+    volatile uint32_t    spare[DISPLAY_MUX_MAX_DIGITS];     /**< Second frame when double buffered */
+} display_dma_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         displayDmaWrite
+ *  @package    display_dma
+ *
+ *  @brief      Sets the segment code shown on one digit.
+ *
+ *  @details    Converts the code into the digit BSRR word and stores it into
+ *              the back frame with one word write.
+ *
+ *  @param      display [in] : Driver instance.
+ *  @param      digit   [in] : Digit position, 0 is the first digit enable pin.
+ *  @param      code    [in] : Segment code, e.g. display_number[DISPLAY_NUM_7].
+ */
+static inline void displayDmaWrite(display_dma_t *display, uint8_t digit, uint8_t code)
+{
+    display->mux.back->code[digit] = code;
+    display->back[digit]           = displayMuxDigitWord(&display->mux, digit, code);
+}
+
+/**
+ *  @fn         displayDmaWrite4
+ *  @package    display_dma
+ *
+ *  @brief      Sets the segment codes of four consecutive digits.
+ *
+ *  @details    The DMA source holds one BSRR word per digit, so each code is
+ *              still converted on its own; only the glyph lookups are saved.
+ *
+ *  @param      display [in] : Driver instance.
+ *  @param      group   [in] : Digits 4 * group .. 4 * group + 3.
+ *  @param      word    [in] : Packed codes, e.g. displayPackDecimal4(), the
+ *                             lowest byte on the lowest digit.
+ */
+static inline void displayDmaWrite4(display_dma_t *display, uint8_t group, uint32_t word)
+{
+    uint8_t digit = (uint8_t)(group << 2u);
+    uint8_t index = 0u;
+
+    for (index = 0u; index < 4u; index++)
+    {
+        displayDmaWrite(display, (uint8_t)(digit + index), (uint8_t)(word >> (8u * index)));
+    }
+}
+
+/**
+ *  @fn         displayDmaClearFlags
+ *  @package    display_dma
+ *
+ *  @brief      Clears the event flags of a DMA stream.
+ *
+ *  @details    The flags of streams 0..3 live in LIFCR and those of 4..7 in
+ *              HIFCR, at bit offsets 0, 6, 16 and 22.
+ *
+ *  @param      dma    [in] : DMA controller owning the stream.
+ *  @param      stream [in] : Stream whose flags are cleared.
+ */
+static inline void displayDmaClearFlags(DMA_TypeDef *dma, DMA_Stream_TypeDef *stream)
+{
+    static const uint8_t flag_offset[4u] = { 0u, 6u, 16u, 22u };
+
+    uint32_t index =
+    (
+        ((uint32_t)((uintptr_t)stream - (uintptr_t)dma) - 0x10u) / 0x18u
+    );
+
+    if (index < 4u)
+    {
+        dma->LIFCR = (DISPLAY_DMA_STREAM_FLAGS << flag_offset[index]);
+    }
+    else
+    {
+        dma->HIFCR = (DISPLAY_DMA_STREAM_FLAGS << flag_offset[index - 4u]);
+    }
+}
+
+/**
+ *  @fn         displayDmaStreamStop
+ *  @package    display_dma
+ *
+ *  @brief      Disables a stream and waits until its ongoing beat is done.
+ *
+ *  @param      stream [in] : Stream to be stopped.
+ */
+static inline void displayDmaStreamStop(DMA_Stream_TypeDef *stream)
+{
+    stream->CR &= ~DMA_SxCR_EN;
+
+    while ((stream->CR & DMA_SxCR_EN) != 0u)
+    {
+        /* Wait for the ongoing beat to finish */
+    }
+}
+
+/**
+ *  @fn         displayDmaStreamProgram
+ *  @package    display_dma
+ *
+ *  @brief      Programs and enables a DMA stream.
+ *
+ *  @details    Stops the stream and clears its flags first, so it can be called
+ *              again on a running stream. The direction comes from the DIR bits
+ *              of `control`; memory-to-peripheral needs DMA2 on GPIO targets.
+ *              M1AR is left alone: a DBM caller sets it on the stopped stream.
+ *
+ *  @param      dma     [in] : DMA controller owning the stream.
+ *  @param      stream  [in] : Stream to be programmed.
+ *  @param      source  [in] : Memory address of the first beat (M0AR).
+ *  @param      target  [in] : Peripheral register of every beat (PAR).
+ *  @param      count   [in] : Beats per cycle of the stream.
+ *  @param      control [in] : SxCR value without EN (channel, sizes, modes).
+ */
+static inline void displayDmaStreamProgram(DMA_TypeDef *dma, DMA_Stream_TypeDef *stream,
+                                           uintptr_t source, uintptr_t target,
+                                           uint32_t count, uint32_t control)
+{
+    /* Stop the stream before touching it ------------------------------------*/
+    displayDmaStreamStop(stream);
+
+    displayDmaClearFlags(dma, stream);
+
+    stream->PAR  = (uint32_t)target;
+    stream->M0AR = (uint32_t)source;
+    stream->NDTR = count;
+    stream->FCR  = 0u;
+    stream->CR   = control;
+
+    stream->CR  |= DMA_SxCR_EN;
+}
+
+/**
+ *  @fn         displayDmaStreamStart
+ *  @package    display_dma
+ *
+ *  @brief      Starts a circular memory-to-peripheral stream of 32-bit beats.
+ *
+ *  @details    Each request of `channel` moves one word from `source` to
+ *              `target`.
+ *
+ *  @param      dma     [in] : DMA controller owning the stream, must be DMA2.
+ *  @param      stream  [in] : Stream to be programmed.
+ *  @param      channel [in] : Request channel of that stream.
+ *  @param      source  [in] : First word of the circular source.
+ *  @param      target  [in] : Peripheral register written by every beat.
+ *  @param      count   [in] : Words of the source.
+ *  @param      walk    [in] : 1u to walk the source, 0u to repeat one word.
+ */
+static inline void displayDmaStreamStart(DMA_TypeDef *dma, DMA_Stream_TypeDef *stream,
+                                         uint32_t channel, volatile const uint32_t *source,
+                                         volatile uint32_t *target, uint32_t count, uint8_t walk)
+{
+    displayDmaStreamProgram(dma, stream, (uintptr_t)source, (uintptr_t)target, count,
+    (
+        (channel << DMA_SxCR_CHSEL_Pos) |
+        DMA_SxCR_PL_1    |      /* High priority */
+        DMA_SxCR_MSIZE_1 |      /* 32-bit memory beats */
+        DMA_SxCR_PSIZE_1 |      /* 32-bit peripheral beats */
+        ((walk != 0u) ? DMA_SxCR_MINC : 0u) |
+        DMA_SxCR_CIRC    |      /* Restart at the first word */
+        DMA_SxCR_DIR_0          /* Memory to peripheral */
+    ));
+}
+
+/**
+ *  @fn         displayDmaBackFree
+ *  @package    display_dma
+ *
+ *  @brief      Tells whether the back frame may be written.
+ *
+ *  @param      display [in] : Driver instance.
+ *
+ *  @return     1u if no presented frame is in flight, 0u otherwise.
+ */
+static inline uint8_t displayDmaBackFree(const display_dma_t *display)
+{
+    return (uint8_t)(display->swap == DISPLAY_SWAP_IDLE);
+}
+
+/**
+ *  @fn         displayDmaPresent
+ *  @package    display_dma
+ *
+ *  @brief      Hands the back frame over to the stream.
+ *
+ *  @details    A single byte store. The frame interrupt takes it at the end of
+ *              the frame being streamed, and the stream shows it one frame
+ *              later. Only meaningful with `layout.double_buffer` set.
+ *
+ *  @param      display [inout] : Driver instance.
+ */
+static inline void displayDmaPresent(display_dma_t *display)
+{
+    display->swap = DISPLAY_SWAP_PENDING;
+}
+
+/**
+ *  @fn         displayDmaFrameIrqHandler
+ *  @package    display_dma
+ *
+ *  @brief      Advances a presented frame; call it from the stream vector.
+ *
+ *  @details    Runs once per frame, on transfer complete, right after the
+ *              hardware switched address registers. It performs the following
+ *              actions:
+ *
+ *                  - Clears the stream flags.
+ *                  - An exchanged frame is now being streamed, so the old front
+ *                    gets a copy of it and is released as the back frame.
+ *                  - A presented frame is exchanged with the front one.
+ *                  - Points the idle address register at the front frame, so
+ *                    the next frame streams it whatever happened above.
+ *
+ *              The idle register has one frame period to be written, which
+ *              bounds the interrupt latency this handler tolerates.
+ *
+ *  @param      display [inout] : Driver instance.
+ */
+static inline void displayDmaFrameIrqHandler(display_dma_t *display)
+{
+    DMA_Stream_TypeDef *stream = display->stream;
+
+    volatile uint32_t *front = display->front;
+    uint8_t            index = 0u;
+
+    displayDmaClearFlags(display->dma, stream);
+
+    if (display->swap == DISPLAY_SWAP_SWITCHING)
+    {
+        for (index = 0u; index < display->mux.digit_count; index++)
+        {
+            display->back[index] = front[index];
+        }
+
+        display->swap = DISPLAY_SWAP_IDLE;
+    }
+    else if (display->swap == DISPLAY_SWAP_PENDING)
+    {
+        front          = display->back;
+        display->back  = display->front;
+        display->front = front;
+        display->swap  = DISPLAY_SWAP_SWITCHING;
+
+        TRACE_EVENT(TRACE_EVENT_FRAME_SWAP, (front == &display->spare[0]));
+    }
+
+    if ((stream->CR & DMA_SxCR_CT) != 0u)
+    {
+        stream->M0AR = (uint32_t)(uintptr_t)front;
+    }
+    else
+    {
+        stream->M1AR = (uint32_t)(uintptr_t)front;
+    }
+}
+
+/**
+ *  @fn         displayDmaInit
+ *  @package    display_dma
+ *
+ *  @brief      Configures the port, the timer and the circular DMA stream.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Runs displayMuxSetup() for the pins and the timer period.
+ *                  - Fills the buffer with blank digits, each already carrying
+ *                    its digit enable.
+ *                  - Programs the stream: memory to peripheral, 32-bit beats,
+ *                    memory increment, circular mode, `digit_count` beats per
+ *                    frame, destination GPIOx->BSRR.
+ *                  - With `layout.double_buffer`, adds DBM with both address
+ *                    registers on `bsrr` and the transfer-complete interrupt.
+ *                  - Enables the timer update DMA request and starts the timer.
+ *
+ *  @param      display [out] : Driver instance to be initialised.
+ *  @param      config  [in]  : Layout and DMA resources.
+ *
+ *  @return     DISPLAY_MUX_OK     : if the display is being refreshed.
+ *              DISPLAY_MUX_INVALID: if the configuration can not be honoured.
+ */
+static inline display_mux_status_t displayDmaInit(display_dma_t *display,
+                                                  const display_dma_config_t *config)
+{
+    display_mux_status_t ret = displayMuxSetup(&display->mux, &config->layout);
+
+    uint8_t index = 0u;
+
+    if (ret != DISPLAY_MUX_OK)
+    {
+        goto end_of_function;
+    }
+
+    display->dma    = config->dma;
+    display->stream = config->stream;
+    display->swap   = DISPLAY_SWAP_IDLE;
+    display->front  = &display->bsrr[0];
+    display->back   = (config->layout.double_buffer != 0u) ? &display->spare[0] : &display->bsrr[0];
+
+    for (index = 0u; index < DISPLAY_MUX_MAX_DIGITS; index++)
+    {
+        display->bsrr[index]  = displayMuxDigitWord(&display->mux, index, DISPLAY_CODE_BLANK);
+        display->spare[index] = display->bsrr[index];
+    }
+
+    /* Circular buffer-to-BSRR stream ----------------------------------------*/
+    if (config->layout.double_buffer == 0u)
+    {
+        displayDmaStreamStart(config->dma, config->stream, config->channel, &display->bsrr[0],
+                              &config->layout.port->BSRR, config->layout.digit_count, 1u);
+    }
+    else
+    {
+        displayDmaStreamStop(config->stream);
+
+        config->stream->M1AR = (uint32_t)(uintptr_t)&display->bsrr[0];
+
+        displayDmaStreamProgram(config->dma, config->stream,
+                                (uintptr_t)&display->bsrr[0], (uintptr_t)&config->layout.port->BSRR,
+                                config->layout.digit_count,
+        (
+            (config->channel << DMA_SxCR_CHSEL_Pos) |
+            DMA_SxCR_PL_1    |      /* High priority */
+            DMA_SxCR_MSIZE_1 |      /* 32-bit memory beats */
+            DMA_SxCR_PSIZE_1 |      /* 32-bit peripheral beats */
+            DMA_SxCR_MINC    |      /* Walk the frame */
+            DMA_SxCR_CIRC    |      /* Restart at the first word */
+            DMA_SxCR_DBM     |      /* Alternate M0AR and M1AR every frame */
+            DMA_SxCR_TCIE    |      /* Frame interrupt */
+            DMA_SxCR_DIR_0          /* Memory to peripheral */
+        ));
+
+        NVIC_SetPriority(config->stream_irq, config->stream_priority);
+        NVIC_ClearPendingIRQ(config->stream_irq);
+        NVIC_EnableIRQ(config->stream_irq);
+    }
+
+    /* One DMA request per timer update --------------------------------------*/
+    config->layout.timer->DIER = TIM_DIER_UDE;
+    config->layout.timer->CR1  = (TIM_CR1_ARPE | TIM_CR1_CEN);
+
+end_of_function:
+    return ret;
+}
+
+#endif /* DISPLAY_DMA_H_ */
+/* end of file */
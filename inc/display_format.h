@@ -0,0 +1,285 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes display_format
+ *
+ *  @package    display_format
+ *  @brief      This module provides division-free formatters that turn integers
+ *              into 7-segment frame buffers.
+ *
+ *  @details    The formatters write one segment code per digit, taken from the
+ *              `display_segments.h` views, into a frame buffer such as the back
+ *              frame of `display_mux_t`. `frame[0]` is the leftmost, most
+ *              significant digit and the value is right-aligned on `digits`
+ *              positions.
+ *
+ *              - **Decimal**: each digit is split off with a multiply by the
+ *                reciprocal of 10 instead of `/10` and `%10`. The 32-bit variant
+ *                uses one UMULL (32x32->64, single cycle on the Cortex-M4), the
+ *                16-bit variant a plain 32-bit MUL.
+ *
+ *              - **Hexadecimal**: nibbles are shifted out and mapped straight
+ *                through `display_hexadecimal[]`, no arithmetic at all.
+ *
+ *              - **Blanking**: with `blank_zeros` set, the leading zeros are shown
+ *                as DISPLAY_NUM_NULL / DISPLAY_HEX_NULL. Units are always shown.
+ *                The choice is a conditional select, not a branch.
+ *
+ *              - **Overflow**: a value wider than `digits` fills the frame with
+ *                '-' and reports DISPLAY_FORMAT_OVERFLOW.
+ *
+ *              Worst-case cost, estimated from Cortex-M4 instruction timings
+ *              with zero wait-state tables and the loop fully unrolled by the
+ *              compiler:
+ *
+ *              | Formatter          | Cycles per digit | 4 digits | 10 digits |
+ *              |--------------------|------------------|----------|-----------|
+ *              | displayFormatU16   | ~9               | ~36      | n/a       |
+ *              | displayFormatU32   | ~10              | ~40      | ~100      |
+ *              | displayFormatHex   | ~7               | ~28      | n/a       |
+ *
+ *  @file       display_format.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef DISPLAY_FORMAT_H_
+#define DISPLAY_FORMAT_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "display_segments.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def DISPLAY_FORMAT_RECIP10_U16
+ * @package    display_format
+ * @brief Reciprocal of 10 scaled by 2^19, exact for every 16-bit dividend.
+ */
+#define DISPLAY_FORMAT_RECIP10_U16  (uint32_t)(0xCCCDUL)
+
+/**
+ * @def DISPLAY_FORMAT_SHIFT_U16
+ * @package    display_format
+ * @brief Scale of DISPLAY_FORMAT_RECIP10_U16.
+ */
+#define DISPLAY_FORMAT_SHIFT_U16    (uint32_t)(19U)
+
+/**
+ * @def DISPLAY_FORMAT_RECIP10_U32
+ * @package    display_format
+ * @brief Reciprocal of 10 scaled by 2^35, exact for every 32-bit dividend.
+ */
+#define DISPLAY_FORMAT_RECIP10_U32  (uint64_t)(0xCCCCCCCDULL)
+
+/**
+ * @def DISPLAY_FORMAT_SHIFT_U32
+ * @package    display_format
+ * @brief Scale of DISPLAY_FORMAT_RECIP10_U32.
+ */
+#define DISPLAY_FORMAT_SHIFT_U32    (uint32_t)(35U)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    displayFormatStatus
+ *  @typedef display_format_status_t
+ *  @package    display_format
+ *
+ *  @brief   Result of a formatting request.
+ */
+typedef enum displayFormatStatus
+{
+    DISPLAY_FORMAT_OK       = (uint8_t)(0u),    /**< Value fully shown */
+    DISPLAY_FORMAT_OVERFLOW = (uint8_t)(1u)     /**< Value does not fit, frame shows '-' */
+} display_format_status_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         displayFormatOverflow
+ *  @package    display_format
+ *
+ *  @brief      Fills a frame with '-' to flag a value that does not fit.
+ *
+ *  @param      frame  [out] : Frame buffer, one segment code per digit.
+ *  @param      digits [in]  : Number of digits of the frame.
+ *
+ *  @return     DISPLAY_FORMAT_OVERFLOW.
+ */
+static inline display_format_status_t displayFormatOverflow(volatile uint8_t *frame, uint8_t digits)
+{
+    uint8_t index = 0u;
+
+    for (index = 0u; index < digits; index++)
+    {
+        frame[index] = DISPLAY_FONT_CODE(DISPLAY_GLYPH_MINUS);
+    }
+
+    return DISPLAY_FORMAT_OVERFLOW;
+}
+
+/**
+ *  @fn         displayFormatU16
+ *  @package    display_format
+ *
+ *  @brief      Writes a 16-bit value as decimal digits into a frame.
+ *
+ *  @details    Going from the units up, each step computes the quotient with
+ *              `(value * 0xCCCD) >> 19` and the digit as `value - quotient * 10`.
+ *              A position is blanked when the value left above it is zero.
+ *
+ *  @param      frame       [out] : Frame buffer, one segment code per digit.
+ *  @param      digits      [in]  : Number of digits of the frame.
+ *  @param      value       [in]  : Value to be shown.
+ *  @param      blank_zeros [in]  : 1u to blank the leading zeros.
+ *
+ *  @return     DISPLAY_FORMAT_OK      : if the value fits in `digits`.
+ *              DISPLAY_FORMAT_OVERFLOW: if it does not.
+ */
+static inline display_format_status_t displayFormatU16(volatile uint8_t *frame, uint8_t digits,
+                                                       uint16_t value, uint8_t blank_zeros)
+{
+    display_format_status_t ret = DISPLAY_FORMAT_OK;
+
+    uint32_t remaining = value;
+    uint32_t quotient  = 0u;
+    uint32_t digit     = 0u;
+    uint8_t  position  = digits;
+
+    while (position > 0u)
+    {
+        position--;
+
+        quotient = ((remaining * DISPLAY_FORMAT_RECIP10_U16) >> DISPLAY_FORMAT_SHIFT_U16);
+        digit    = (remaining - (quotient * 10u));
+
+        digit    = ((blank_zeros != 0u) && (remaining == 0u) && (position != (digits - 1u))) ?
+                   DISPLAY_NUM_NULL : digit;
+
+        frame[position] = display_number[digit];
+
+        remaining = quotient;
+    }
+
+    if (remaining != 0u)
+    {
+        ret = displayFormatOverflow(frame, digits);
+    }
+
+    return ret;
+}
+
+/**
+ *  @fn         displayFormatU32
+ *  @package    display_format
+ *
+ *  @brief      Writes a 32-bit value as decimal digits into a frame.
+ *
+ *  @details    Same scheme as displayFormatU16(), with the quotient taken from
+ *              the high word of `value * 0xCCCCCCCD`, shifted right by 3.
+ *
+ *  @param      frame       [out] : Frame buffer, one segment code per digit.
+ *  @param      digits      [in]  : Number of digits of the frame.
+ *  @param      value       [in]  : Value to be shown.
+ *  @param      blank_zeros [in]  : 1u to blank the leading zeros.
+ *
+ *  @return     DISPLAY_FORMAT_OK      : if the value fits in `digits`.
+ *              DISPLAY_FORMAT_OVERFLOW: if it does not.
+ */
+static inline display_format_status_t displayFormatU32(volatile uint8_t *frame, uint8_t digits,
+                                                       uint32_t value, uint8_t blank_zeros)
+{
+    display_format_status_t ret = DISPLAY_FORMAT_OK;
+
+    uint32_t remaining = value;
+    uint32_t quotient  = 0u;
+    uint32_t digit     = 0u;
+    uint8_t  position  = digits;
+
+    while (position > 0u)
+    {
+        position--;
+
+        quotient = (uint32_t)(((uint64_t)remaining * DISPLAY_FORMAT_RECIP10_U32) >> DISPLAY_FORMAT_SHIFT_U32);
+        digit    = (remaining - (quotient * 10u));
+
+        digit    = ((blank_zeros != 0u) && (remaining == 0u) && (position != (digits - 1u))) ?
+                   DISPLAY_NUM_NULL : digit;
+
+        frame[position] = display_number[digit];
+
+        remaining = quotient;
+    }
+
+    if (remaining != 0u)
+    {
+        ret = displayFormatOverflow(frame, digits);
+    }
+
+    return ret;
+}
+
+/**
+ *  @fn         displayFormatHex
+ *  @package    display_format
+ *
+ *  @brief      Writes a 32-bit value as hexadecimal digits into a frame.
+ *
+ *  @details    Each nibble indexes `display_hexadecimal[]` directly.
+ *
+ *  @param      frame       [out] : Frame buffer, one segment code per digit.
+ *  @param      digits      [in]  : Number of digits of the frame.
+ *  @param      value       [in]  : Value to be shown.
+ *  @param      blank_zeros [in]  : 1u to blank the leading zeros.
+ *
+ *  @return     DISPLAY_FORMAT_OK      : if the value fits in `digits`.
+ *              DISPLAY_FORMAT_OVERFLOW: if it does not.
+ */
+static inline display_format_status_t displayFormatHex(volatile uint8_t *frame, uint8_t digits,
+                                                       uint32_t value, uint8_t blank_zeros)
+{
+    display_format_status_t ret = DISPLAY_FORMAT_OK;
+
+    uint32_t remaining = value;
+    uint32_t nibble    = 0u;
+    uint8_t  position  = digits;
+
+    while (position > 0u)
+    {
+        position--;
+
+        nibble = (remaining & 0xFu);
+
+        nibble = ((blank_zeros != 0u) && (remaining == 0u) && (position != (digits - 1u))) ?
+                 DISPLAY_HEX_NULL : nibble;
+
+        frame[position] = display_hexadecimal[nibble];
+
+        remaining >>= 4u;
+    }
+
+    if (remaining != 0u)
+    {
+        ret = displayFormatOverflow(frame, digits);
+    }
+
+    return ret;
+}
+
+#endif /* DISPLAY_FORMAT_H_ */
+/* end of file */
@@ -0,0 +1,356 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes display_marquee
+ *
+ *  @package    display_marquee
+ *  @brief      This module provides a scrolling text engine for 7-segment
+ *              displays, run as a periodic task of `scheduler.h`.
+ *
+ *  @details    A string is rendered once into a ring of segment codes. From
+ *              then on the display is a window sliding over that ring, and no
+ *              glyph is looked up again until the next message is loaded.
+ *
+ *              - **Ring**: the message is followed by `gap` blank codes, and the
+ *                first `digits` codes are repeated after the end. So the window
+ *                is always `digits` contiguous bytes starting at `head`, and a
+ *                scroll step is only `head + 1`, wrapped at the ring length.
+ *
+ *              - **Incremental output**: the engine keeps the code shown on each
+ *                digit and only calls the backend `write` hook for the digits
+ *                whose code changed. A blink phase change rewrites the blinking
+ *                digits only; a short message that fits the display never
+ *                scrolls and is written once.
+ *
+ *              - **Timing**: displayMarqueeTask() is the body of a scheduler
+ *                task. The scroll speed and the blink rate are counted in runs
+ *                of that task, so they follow the scheduler tick exactly.
+ *
+ *              - **Blink**: `blink_mask` flags display positions, bit `d` for
+ *                digit `d`. Those digits are blank during the off phase.
+ *
+ *              The `write` hook takes the backend instance and a digit position,
+ *              0 being the leftmost, e.g. a wrapper over displayMuxWrite(),
+ *              displayDmaWrite() or displayShiftWrite().
+ *
+ *  @file       display_marquee.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef DISPLAY_MARQUEE_H_
+#define DISPLAY_MARQUEE_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stddef.h>
+#include <stdint.h>
+
+/* Implementeds */
+#include "display_segments.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def DISPLAY_MARQUEE_MAX_DIGITS
+ * @package    display_marquee
+ * @brief Widest display driven by one engine, the longest 74HC595 chain.
+ */
+#define DISPLAY_MARQUEE_MAX_DIGITS  (uint8_t)(32U)
+
+/**
+ * @def DISPLAY_MARQUEE_MAX_RING
+ * @package    display_marquee
+ * @brief Longest ring, message plus gap.
+ */
+#define DISPLAY_MARQUEE_MAX_RING    (uint8_t)(64U)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    displayMarqueeStatus
+ *  @typedef display_marquee_status_t
+ *  @package    display_marquee
+ *
+ *  @brief   Result of a marquee request.
+ */
+typedef enum displayMarqueeStatus
+{
+    DISPLAY_MARQUEE_OK      = (uint8_t)(0u),    /**< Request applied */
+    DISPLAY_MARQUEE_INVALID = (uint8_t)(1u)     /**< Rejected configuration or message */
+} display_marquee_status_t;
+
+/**
+ * @typedef display_marquee_write_fn
+ * @package    display_marquee
+ * @brief Backend hook storing one segment code.
+ *
+ * @param display Backend instance of the configuration.
+ * @param digit   Digit position, 0 is the leftmost.
+ * @param code    Segment code.
+ */
+typedef void (*display_marquee_write_fn)(void *display, uint8_t digit, uint8_t code);
+
+/**
+ *  @struct  displayMarqueeConfig
+ *  @typedef display_marquee_config_t
+ *  @package    display_marquee
+ *
+ *  @brief   Backend and timing of a marquee.
+ */
+typedef struct displayMarqueeConfig
+{
+    display_marquee_write_fn  write;        /**< Backend hook */
+    void                     *display;      /**< First argument of `write` */
+    uint8_t                   digits;       /**< Display width, 1..DISPLAY_MARQUEE_MAX_DIGITS */
+    uint16_t                  step_ticks;   /**< Task runs per scroll step, 0 to never scroll */
+    uint16_t                  blink_ticks;  /**< Task runs per blink phase, 0 to never blink */
+} display_marquee_config_t;
+
+/**
+ *  @struct  displayMarquee
+ *  @typedef display_marquee_t
+ *  @package    display_marquee
+ *
+ *  @brief   Runtime state of a marquee.
+ *
+ *  @details Only touched from the scheduler task context.
+ */
+typedef struct displayMarquee
+{
+    display_marquee_write_fn  write;                                    /**< Backend hook */
+    void                     *display;                                  /**< First argument of `write` */
+    uint32_t                  blink_mask;                               /**< Blinking positions */
+    uint16_t                  step_ticks;                               /**< Task runs per scroll step */
+    uint16_t                  step_left;                                /**< Runs before the next step */
+    uint16_t                  blink_ticks;                              /**< Task runs per blink phase */
+    uint16_t                  blink_left;                               /**< Runs before the next phase */
+    uint8_t                   digits;                                   /**< Display width */
+    uint8_t                   length;                                   /**< Ring length, message plus gap */
+    uint8_t                   head;                                     /**< Ring index of the leftmost digit */
+    uint8_t                   blink_off;                                /**< 1u during the off phase */
+    uint8_t                   shown[DISPLAY_MARQUEE_MAX_DIGITS];        /**< Code written on each digit */
+    uint8_t                   ring[DISPLAY_MARQUEE_MAX_RING + DISPLAY_MARQUEE_MAX_DIGITS]; /**< Codes, window tail repeated */
+} display_marquee_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         displayMarqueeRender
+ *  @package    display_marquee
+ *
+ *  @brief      Writes the digits of the window whose code changed.
+ *
+ *  @details    One ring load, one select and one compare per digit; the hook
+ *              only runs on a change, or on every digit with `force`.
+ *
+ *  @param      marquee [inout] : Engine instance.
+ *  @param      force   [in]    : 1u to write every digit.
+ */
+static inline void displayMarqueeRender(display_marquee_t *marquee, uint8_t force)
+{
+    const uint8_t *window = &marquee->ring[marquee->head];
+
+    uint32_t hidden = (marquee->blink_off != 0u) ? marquee->blink_mask : 0u;
+    uint8_t  digit  = 0u;
+
+    for (digit = 0u; digit < marquee->digits; digit++)
+    {
+        uint8_t code = (((hidden >> digit) & 1u) != 0u) ? DISPLAY_CODE_BLANK : window[digit];
+
+        if ((force != 0u) || (code != marquee->shown[digit]))
+        {
+            marquee->shown[digit] = code;
+            marquee->write(marquee->display, digit, code);
+        }
+    }
+}
+
+/**
+ *  @fn         displayMarqueeInit
+ *  @package    display_marquee
+ *
+ *  @brief      Binds a marquee to its backend and blanks the display.
+ *
+ *  @param      marquee [out] : Engine instance.
+ *  @param      config  [in]  : Backend and timing.
+ *
+ *  @return     DISPLAY_MARQUEE_OK     : if the display was blanked.
+ *              DISPLAY_MARQUEE_INVALID: if the hook is missing or the width is
+ *                                       out of range.
+ */
+static inline display_marquee_status_t displayMarqueeInit(display_marquee_t *marquee,
+                                                          const display_marquee_config_t *config)
+{
+    display_marquee_status_t ret = DISPLAY_MARQUEE_INVALID;
+
+    uint8_t index = 0u;
+
+    if ((config->write == NULL) || (config->digits == 0u) ||
+        (config->digits > DISPLAY_MARQUEE_MAX_DIGITS))
+    {
+        goto end_of_function;
+    }
+
+    marquee->write       = config->write;
+    marquee->display     = config->display;
+    marquee->blink_mask  = 0u;
+    marquee->step_ticks  = config->step_ticks;
+    marquee->step_left   = config->step_ticks;
+    marquee->blink_ticks = config->blink_ticks;
+    marquee->blink_left  = config->blink_ticks;
+    marquee->digits      = config->digits;
+    marquee->length      = config->digits;
+    marquee->head        = 0u;
+    marquee->blink_off   = 0u;
+
+    for (index = 0u; index < sizeof(marquee->ring); index++)
+    {
+        marquee->ring[index] = DISPLAY_CODE_BLANK;
+    }
+
+    displayMarqueeRender(marquee, 1u);
+
+    ret = DISPLAY_MARQUEE_OK;
+
+end_of_function:
+    return ret;
+}
+
+/**
+ *  @fn         displayMarqueeLoad
+ *  @package    display_marquee
+ *
+ *  @brief      Renders a message into the ring and shows its start.
+ *
+ *  @details    The only place where glyphs are looked up, one displayFontLookup()
+ *              per character. A message that fits the display is padded with
+ *              blanks and stays still; a longer one scrolls right to left,
+ *              followed by `gap` blank digits before it starts over.
+ *
+ *  @param      marquee [inout] : Initialised engine.
+ *  @param      text    [in]    : Null-terminated message.
+ *  @param      gap     [in]    : Blank digits between two passes of a long message.
+ *
+ *  @return     DISPLAY_MARQUEE_OK     : if the message is shown.
+ *              DISPLAY_MARQUEE_INVALID: if message and gap exceed the ring; the
+ *                                       previous message is kept.
+ */
+static inline display_marquee_status_t displayMarqueeLoad(display_marquee_t *marquee,
+                                                          const char *text, uint8_t gap)
+{
+    display_marquee_status_t ret = DISPLAY_MARQUEE_INVALID;
+
+    uint32_t characters = 0u;
+    uint32_t length     = 0u;
+    uint32_t index      = 0u;
+
+    while ((text[characters] != '\0') && (characters <= DISPLAY_MARQUEE_MAX_RING))
+    {
+        characters++;
+    }
+
+    length = (characters > marquee->digits) ? (characters + gap) : marquee->digits;
+
+    if (length > DISPLAY_MARQUEE_MAX_RING)
+    {
+        goto end_of_function;
+    }
+
+    for (index = 0u; index < characters; index++)
+    {
+        marquee->ring[index] = displayFontLookup(text[index]);
+    }
+
+    for (; index < length; index++)
+    {
+        marquee->ring[index] = DISPLAY_CODE_BLANK;
+    }
+
+    /* Window tail, so that the window never wraps -------------------------*/
+    for (index = 0u; index < marquee->digits; index++)
+    {
+        marquee->ring[length + index] = marquee->ring[index];
+    }
+
+    marquee->length    = (uint8_t)length;
+    marquee->head      = 0u;
+    marquee->step_left = marquee->step_ticks;
+
+    displayMarqueeRender(marquee, 0u);
+
+    ret = DISPLAY_MARQUEE_OK;
+
+end_of_function:
+    return ret;
+}
+
+/**
+ *  @fn         displayMarqueeSetBlink
+ *  @package    display_marquee
+ *
+ *  @brief      Selects the blinking digits.
+ *
+ *  @param      marquee [inout] : Initialised engine.
+ *  @param      mask    [in]    : Bit `d` set to blink digit `d`.
+ */
+static inline void displayMarqueeSetBlink(display_marquee_t *marquee, uint32_t mask)
+{
+    marquee->blink_mask = mask;
+
+    displayMarqueeRender(marquee, 0u);
+}
+
+/**
+ *  @fn         displayMarqueeTask
+ *  @package    display_marquee
+ *
+ *  @brief      Scheduler task body: scrolls and blinks the display.
+ *
+ *  @details    Counts down the step and blink periods, and renders only on the
+ *              runs where one of them expires. The other runs are two
+ *              decrements and two compares.
+ *
+ *  @param      context [inout] : The `display_marquee_t` of the task.
+ */
+static inline void displayMarqueeTask(void *context)
+{
+    display_marquee_t *marquee = (display_marquee_t *)context;
+
+    uint8_t changed = 0u;
+
+    if ((marquee->step_ticks != 0u) && (marquee->length > marquee->digits) &&
+        (--marquee->step_left == 0u))
+    {
+        marquee->step_left = marquee->step_ticks;
+        marquee->head      = (uint8_t)((marquee->head + 1u < marquee->length) ? (marquee->head + 1u) : 0u);
+
+        changed = 1u;
+    }
+
+    if ((marquee->blink_ticks != 0u) && (--marquee->blink_left == 0u))
+    {
+        marquee->blink_left = marquee->blink_ticks;
+        marquee->blink_off ^= 1u;
+
+        changed = (uint8_t)(changed | (marquee->blink_mask != 0u));
+    }
+
+    if (changed != 0u)
+    {
+        displayMarqueeRender(marquee, 0u);
+    }
+}
+
+#endif /* DISPLAY_MARQUEE_H_ */
+/* end of file */
@@ -0,0 +1,539 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes display_mux
+ *
+ *  @package    display_mux
+ *  @brief      This module provides a timer-interrupt driver that multiplexes a
+ *              multi-digit 7-segment display from a RAM frame buffer.
+ *
+ *  @details    The application fills a frame buffer with segment codes taken
+ *              from the `display_segments.h` tables, one byte per digit. A timer
+ *              update interrupt then lights one digit per period, scanning the
+ *              whole display `refresh_hz` times per second.
+ *
+ *              - **Wiring**: the 8 segment lines (a..g, dp) sit on consecutive
+ *                pins of one GPIO port starting at `segment_shift`, and the digit
+ *                enables on consecutive pins of the same port starting at
+ *                `digit_shift`. Digit enables can be active high or low.
+ *
+ *              - **Refresh**: each update interrupt is a handful of loads and a
+ *                single BSRR store that switches the segments and the digit
+ *                enables at once, so there is no ghosting window between
+ *                turning the previous digit off and the next one on.
+ *
+ *              - **Ownership**: the driver keeps all its state in a caller-owned
+ *                `display_mux_t`. The application only writes the frame buffer
+ *                and calls displayMuxIrqHandler() from the timer vector, so the
+ *                refresh cost never shows up in the application code.
+ *
+ *              - **Double buffering**: with `double_buffer` set, the application
+ *                writes a back frame while the interrupt scans the front one,
+ *                then calls displayMuxPresent(). The interrupt exchanges the two
+ *                frame pointers when it wraps to digit 0, so a scan never mixes
+ *                two frames, and neither side takes a lock. Right after the
+ *                exchange the new back frame gets a copy of the new front one,
+ *                so a producer that only rewrites the digits that changed still
+ *                renders complete frames. displayMuxBackFree() tells whether a
+ *                presented frame is still waiting for the wrap.
+ *
+ *              The timer and GPIO clocks have to be enabled by the caller before
+ *              displayMuxInit() runs.
+ *
+ *  @file       display_mux.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef DISPLAY_MUX_H_
+#define DISPLAY_MUX_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+#include "gpio_output.h"
+#include "display_segments.h"
+#include "trace_itm.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def DISPLAY_MUX_MAX_DIGITS
+ * @package    display_mux
+ * @brief Maximum number of digits scanned by one driver instance.
+ *
+ * @details 8 digits plus the 8 segment lines fill a whole 16-pin port.
+ */
+#define DISPLAY_MUX_MAX_DIGITS      (uint8_t)(8U)
+
+/**
+ * @def DISPLAY_MUX_FRAME_WORDS
+ * @package    display_mux
+ * @brief Words of the frame buffer, four digits each.
+ */
+#define DISPLAY_MUX_FRAME_WORDS     (uint8_t)(DISPLAY_MUX_MAX_DIGITS / 4U)
+
+/**
+ * @def DISPLAY_MUX_FRAMES
+ * @package    display_mux
+ * @brief Frame buffers of a driver instance, front and back.
+ */
+#define DISPLAY_MUX_FRAMES          (uint8_t)(2U)
+
+/**
+ * @def DISPLAY_MUX_SEGMENT_LINES
+ * @package    display_mux
+ * @brief Number of segment lines of one digit (a..g and dp).
+ */
+#define DISPLAY_MUX_SEGMENT_LINES   (uint8_t)(8U)
+
+/**
+ * @def DISPLAY_MUX_SEGMENT_MASK
+ * @package    display_mux
+ * @brief Mask of the segment lines of one digit before shifting.
+ */
+#define DISPLAY_MUX_SEGMENT_MASK    (uint32_t)(0xFFU)
+
+/**
+ * @def DISPLAY_MUX_TIMER_MAX
+ * @package    display_mux
+ * @brief Largest value of a 16-bit timer prescaler or auto-reload register.
+ */
+#define DISPLAY_MUX_TIMER_MAX       (uint32_t)(0x10000UL)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    displayMuxStatus
+ *  @typedef display_mux_status_t
+ *  @package    display_mux
+ *
+ *  @brief   Result of the driver configuration.
+ */
+typedef enum displayMuxStatus
+{
+    DISPLAY_MUX_OK          = (uint8_t)(0u),    /**< Driver configured and running */
+    DISPLAY_MUX_INVALID     = (uint8_t)(1u)     /**< Rejected configuration */
+} display_mux_status_t;
+
+/**
+ *  @enum    displaySwap
+ *  @typedef display_swap_t
+ *  @package    display_mux
+ *
+ *  @brief   Progress of a presented back frame, shared by the refresh backends.
+ */
+typedef enum displaySwap
+{
+    DISPLAY_SWAP_IDLE       = (uint8_t)(0u),    /**< Back frame free for the application */
+    DISPLAY_SWAP_PENDING    = (uint8_t)(1u),    /**< Presented, waiting for the frame boundary */
+    DISPLAY_SWAP_SWITCHING  = (uint8_t)(2u)     /**< Exchanged, old front still being read */
+} display_swap_t;
+
+/**
+ *  @union   displayMuxFrame
+ *  @typedef display_mux_frame_t
+ *  @package    display_mux
+ *
+ *  @brief   One frame of segment codes, addressable by digit or by word.
+ */
+typedef union displayMuxFrame
+{
+    volatile uint8_t  code[DISPLAY_MUX_MAX_DIGITS];         /**< Segment code per digit */
+    volatile uint32_t word[DISPLAY_MUX_FRAME_WORDS];        /**< Same codes, four per word */
+} display_mux_frame_t;
+
+/**
+ *  @struct  displayMuxConfig
+ *  @typedef display_mux_config_t
+ *  @package    display_mux
+ *
+ *  @brief   Hardware and timing description of a multiplexed display.
+ */
+typedef struct displayMuxConfig
+{
+    TIM_TypeDef     *timer;             /**< Timer providing the scan period */
+    IRQn_Type        timer_irq;         /**< Update interrupt of that timer */
+    uint32_t         timer_priority;    /**< NVIC priority of the scan interrupt */
+    uint32_t         timer_clock_hz;    /**< Timer kernel clock */
+    uint32_t         refresh_hz;        /**< Full display frames per second */
+    GPIO_TypeDef    *port;              /**< Port holding segments and digit enables */
+    uint8_t          segment_shift;     /**< Pin of segment a, dp at segment_shift + 7 */
+    uint8_t          digit_shift;       /**< Pin of the first digit enable */
+    uint8_t          digit_count;       /**< Digits scanned, 1..DISPLAY_MUX_MAX_DIGITS */
+    uint8_t          digit_active_low;  /**< 1u if a digit is enabled by a low level */
+    uint8_t          double_buffer;     /**< 1u to render into a back frame, see displayMuxPresent() */
+} display_mux_config_t;
+
+/**
+ *  @struct  displayMux
+ *  @typedef display_mux_t
+ *  @package    display_mux
+ *
+ *  @brief   Runtime state of a multiplexed display.
+ *
+ *  @details `back` is the only frame the application is expected to write,
+ *           through displayMuxWrite(), displayMuxWrite4() or directly. Without
+ *           `double_buffer`, `front` and `back` both point at `frames[0]` and
+ *           a write shows on the next scan of its digit.
+ */
+typedef struct displayMux
+{
+    TIM_TypeDef     *timer;                                 /**< Scan timer */
+    GPIO_TypeDef    *port;                                  /**< Driven port */
+    uint32_t         segment_mask;                          /**< Segment pins of the port */
+    uint32_t         digit_word[DISPLAY_MUX_MAX_DIGITS];    /**< BSRR digit enables per digit */
+    uint8_t          segment_shift;                         /**< Pin of segment a */
+    uint8_t          digit_count;                           /**< Digits scanned */
+    volatile uint8_t current;                               /**< Digit lit by the next interrupt */
+    volatile uint8_t swap;                                  /**< display_swap_t of the back frame */
+
+    display_mux_frame_t *volatile front;                    /**< Frame scanned by the interrupt */
+    display_mux_frame_t *volatile back;                     /**< Frame written by the application */
+    display_mux_frame_t  frames[DISPLAY_MUX_FRAMES];        /**< Storage of both frames */
+} display_mux_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         displayMuxWrite
+ *  @package    display_mux
+ *
+ *  @brief      Sets the segment code shown on one digit.
+ *
+ *  @details    A single byte store into the back frame, picked up on the next
+ *              scan of that digit, or after displayMuxPresent() when double
+ *              buffered.
+ *
+ *  @param      mux   [in] : Driver instance.
+ *  @param      digit [in] : Digit position, 0 is the first digit enable pin.
+ *  @param      code  [in] : Segment code, e.g. display_number[DISPLAY_NUM_7].
+ */
+static inline void displayMuxWrite(display_mux_t *mux, uint8_t digit, uint8_t code)
+{
+    mux->back->code[digit] = code;
+}
+
+/**
+ *  @fn         displayMuxWrite4
+ *  @package    display_mux
+ *
+ *  @brief      Sets the segment codes of four consecutive digits.
+ *
+ *  @details    A single word store. The interrupt reads one byte per period,
+ *              so it sees each digit either fully old or fully new.
+ *
+ *  @param      mux   [in] : Driver instance.
+ *  @param      group [in] : Digits 4 * group .. 4 * group + 3.
+ *  @param      word  [in] : Packed codes, e.g. displayPackDecimal4(), the
+ *                           lowest byte on the lowest digit.
+ */
+static inline void displayMuxWrite4(display_mux_t *mux, uint8_t group, uint32_t word)
+{
+    mux->back->word[group] = word;
+}
+
+/**
+ *  @fn         displayMuxBackFree
+ *  @package    display_mux
+ *
+ *  @brief      Tells whether the back frame may be written.
+ *
+ *  @details    Between displayMuxPresent() and the next frame boundary the
+ *              back frame is about to be scanned and must be left alone. The
+ *              check is one load, so a producer can poll it from its own loop.
+ *
+ *  @param      mux [in] : Driver instance.
+ *
+ *  @return     1u if no presented frame is waiting, 0u otherwise.
+ */
+static inline uint8_t displayMuxBackFree(const display_mux_t *mux)
+{
+    return (uint8_t)(mux->swap == DISPLAY_SWAP_IDLE);
+}
+
+/**
+ *  @fn         displayMuxPresent
+ *  @package    display_mux
+ *
+ *  @brief      Hands the back frame over to the scan.
+ *
+ *  @details    A single byte store. The interrupt picks the frame up when it
+ *              wraps to digit 0, at most one frame period later. The frame
+ *              stores were issued before this one, and the core does not
+ *              reorder stores seen by its own interrupts, so no barrier is
+ *              needed. Without `double_buffer` this is a no-op swap.
+ *
+ *  @param      mux [inout] : Driver instance.
+ */
+static inline void displayMuxPresent(display_mux_t *mux)
+{
+    mux->swap = DISPLAY_SWAP_PENDING;
+}
+
+/**
+ *  @fn         displayMuxSwap
+ *  @package    display_mux
+ *
+ *  @brief      Exchanges front and back at a frame boundary; interrupt side.
+ *
+ *  @details    The new back frame is then overwritten with the new front one,
+ *              two word copies, so it starts from what is being shown.
+ *
+ *  @param      mux [inout] : Driver instance.
+ *
+ *  @return     The new front frame.
+ */
+static inline display_mux_frame_t *displayMuxSwap(display_mux_t *mux)
+{
+    display_mux_frame_t *front = mux->back;
+    display_mux_frame_t *back  = mux->front;
+    uint8_t              index = 0u;
+
+    mux->front = front;
+    mux->back  = back;
+
+    for (index = 0u; index < DISPLAY_MUX_FRAME_WORDS; index++)
+    {
+        back->word[index] = front->word[index];
+    }
+
+    mux->swap = DISPLAY_SWAP_IDLE;
+
+    TRACE_EVENT(TRACE_EVENT_FRAME_SWAP, (front == &mux->frames[1]));
+
+    return front;
+}
+
+/**
+ *  @fn         displayMuxDigitWord
+ *  @package    display_mux
+ *
+ *  @brief      Builds the BSRR word that shows `code` on one digit.
+ *
+ *  @details    The word drives every segment line and every digit enable of
+ *              the display, so storing it alone switches to that digit.
+ *
+ *  @param      mux   [in] : Driver instance.
+ *  @param      digit [in] : Digit position to be enabled.
+ *  @param      code  [in] : Segment code to be shown.
+ *
+ *  @return     The 32-bit BSRR word.
+ */
+static inline uint32_t displayMuxDigitWord(const display_mux_t *mux, uint8_t digit, uint8_t code)
+{
+    uint32_t segments = ((uint32_t)code << mux->segment_shift);
+
+    return
+    (
+        (segments & mux->segment_mask) |
+        ((~segments & mux->segment_mask) << GPIO_BSRR_RESET_SHIFT) |
+        mux->digit_word[digit]
+    );
+}
+
+/**
+ *  @fn         displayMuxIrqHandler
+ *  @package    display_mux
+ *
+ *  @brief      Lights the next digit; call it from the scan timer vector.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Acknowledges the update flag first, so a late clear can
+ *                    not re-enter the handler.
+ *                  - On digit 0, swaps in a presented back frame.
+ *                  - Loads the digit code and its precomputed digit enables.
+ *                  - Stores segments and enables in one BSRR write.
+ *                  - Moves to the next digit, wrapping without a division.
+ *
+ *  @param      mux [in] : Driver instance.
+ */
+static inline void displayMuxIrqHandler(display_mux_t *mux)
+{
+    uint8_t digit = mux->current;
+
+    display_mux_frame_t *front = mux->front;
+
+    mux->timer->SR   = ~TIM_SR_UIF;
+
+    if ((digit == 0u) && (mux->swap != DISPLAY_SWAP_IDLE))
+    {
+        front = displayMuxSwap(mux);
+    }
+
+    mux->port->BSRR  = displayMuxDigitWord(mux, digit, front->code[digit]);
+
+    digit++;
+
+    mux->current = (digit >= mux->digit_count) ? 0u : digit;
+}
+
+/**
+ *  @fn         displayMuxSetup
+ *  @package    display_mux
+ *
+ *  @brief      Prepares the port and the scan timer without starting the scan.
+ *
+ *  @details    Shared by every refresh backend of the display. It performs the
+ *              following actions:
+ *
+ *                  - Validates the pin layout and the digit count.
+ *                  - Precomputes, for every digit, the BSRR word that enables it
+ *                    and disables all the others.
+ *                  - Blanks both frames, points `front` and `back` at them (or
+ *                    both at the first one without `double_buffer`) and sets
+ *                    the used pins as outputs.
+ *                  - Derives PSC/ARR for `refresh_hz * digit_count` updates per
+ *                    second and loads them, leaving the timer stopped.
+ *
+ *  @param      mux    [out] : Driver instance to be initialised.
+ *  @param      config [in]  : Hardware and timing description.
+ *
+ *  @return     DISPLAY_MUX_OK     : if the port and the timer are ready.
+ *              DISPLAY_MUX_INVALID: if the configuration can not be honoured.
+ */
+static inline display_mux_status_t displayMuxSetup(display_mux_t *mux,
+                                                   const display_mux_config_t *config)
+{
+    display_mux_status_t ret = DISPLAY_MUX_INVALID;
+
+    uint32_t digit_mask = 0u;
+    uint32_t used_pins  = 0u;
+    uint32_t moder_mask = 0u;
+    uint32_t moder_out  = 0u;
+    uint32_t ticks      = 0u;
+    uint32_t prescaler  = 0u;
+    uint8_t  index      = 0u;
+
+    if ((config->digit_count == 0u) || (config->digit_count > DISPLAY_MUX_MAX_DIGITS) ||
+        (((uint32_t)config->segment_shift + DISPLAY_MUX_SEGMENT_LINES) > 16u) ||
+        (((uint32_t)config->digit_shift + config->digit_count) > 16u) ||
+        (config->refresh_hz == 0u))
+    {
+        goto end_of_function;
+    }
+
+    digit_mask = (((1UL << config->digit_count) - 1u) << config->digit_shift);
+
+    mux->segment_mask = (DISPLAY_MUX_SEGMENT_MASK << config->segment_shift);
+
+    if ((digit_mask & mux->segment_mask) != 0u)
+    {
+        goto end_of_function;
+    }
+
+    ticks = (config->timer_clock_hz / (config->refresh_hz * config->digit_count));
+
+    if (ticks < 2u)
+    {
+        goto end_of_function;
+    }
+
+    prescaler = ((ticks - 1u) / DISPLAY_MUX_TIMER_MAX);
+
+    if (prescaler >= DISPLAY_MUX_TIMER_MAX)
+    {
+        goto end_of_function;
+    }
+
+    /* Runtime state ---------------------------------------------------------*/
+    mux->timer          = config->timer;
+    mux->port           = config->port;
+    mux->segment_shift  = config->segment_shift;
+    mux->digit_count    = config->digit_count;
+    mux->current        = 0u;
+    mux->swap           = DISPLAY_SWAP_IDLE;
+    mux->front          = &mux->frames[0];
+    mux->back           = &mux->frames[(config->double_buffer != 0u) ? 1u : 0u];
+
+    for (index = 0u; index < DISPLAY_MUX_MAX_DIGITS; index++)
+    {
+        uint32_t enabled = (config->digit_active_low != 0u) ?
+                           (digit_mask & ~(1UL << (config->digit_shift + index))) :
+                           (1UL << (config->digit_shift + index));
+
+        mux->digit_word[index]       = GPIO_BSRR_WORD(digit_mask, enabled);
+        mux->frames[0].code[index]   = DISPLAY_CODE_BLANK;
+        mux->frames[1].code[index]   = DISPLAY_CODE_BLANK;
+    }
+
+    /* Segment and digit pins as push-pull outputs ---------------------------*/
+    used_pins = (digit_mask | mux->segment_mask);
+
+    for (index = 0u; index < 16u; index++)
+    {
+        if ((used_pins & (1UL << index)) != 0u)
+        {
+            moder_mask |= (GPIO_MODER_MODER0 << (index * 2u));
+            moder_out  |= (0b01UL << (index * 2u));
+        }
+    }
+
+    config->port->MODER = ((config->port->MODER & ~moder_mask) | moder_out);
+
+    /* Scan timer ------------------------------------------------------------*/
+    config->timer->CR1  = 0u;
+    config->timer->PSC  = prescaler;
+    config->timer->ARR  = ((ticks / (prescaler + 1u)) - 1u);
+    config->timer->EGR  = TIM_EGR_UG;
+    config->timer->SR   = ~TIM_SR_UIF;
+
+    ret = DISPLAY_MUX_OK;
+
+end_of_function:
+    return ret;
+}
+
+/**
+ *  @fn         displayMuxInit
+ *  @package    display_mux
+ *
+ *  @brief      Configures the port, the scan timer and its interrupt.
+ *
+ *  @details    Runs displayMuxSetup(), then enables the update interrupt with
+ *              the configured NVIC priority and starts the timer.
+ *
+ *  @param      mux    [out] : Driver instance to be initialised.
+ *  @param      config [in]  : Hardware and timing description.
+ *
+ *  @return     DISPLAY_MUX_OK     : if the driver is running.
+ *              DISPLAY_MUX_INVALID: if the configuration can not be honoured.
+ */
+static inline display_mux_status_t displayMuxInit(display_mux_t *mux,
+                                                  const display_mux_config_t *config)
+{
+    display_mux_status_t ret = displayMuxSetup(mux, config);
+
+    if (ret != DISPLAY_MUX_OK)
+    {
+        goto end_of_function;
+    }
+
+    config->timer->DIER = TIM_DIER_UIE;
+
+    NVIC_SetPriority(config->timer_irq, config->timer_priority);
+    NVIC_ClearPendingIRQ(config->timer_irq);
+    NVIC_EnableIRQ(config->timer_irq);
+
+    config->timer->CR1  = (TIM_CR1_ARPE | TIM_CR1_CEN);
+
+end_of_function:
+    return ret;
+}
+
+#endif /* DISPLAY_MUX_H_ */
+/* end of file */
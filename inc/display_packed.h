@@ -0,0 +1,279 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes display_packed
+ *
+ *  @package    display_packed
+ *  @brief      This module provides packed multi-digit segment words, so a
+ *              4-digit update is a single 32-bit store.
+ *
+ *  @details    A packed word holds four segment codes, the code of the leftmost
+ *              digit in its low byte. On the little-endian Cortex-M4 that is the
+ *              byte order of a frame buffer, so the word lands as-is on four
+ *              consecutive frame bytes (displayMuxWrite4()). displayShiftWrite4()
+ *              byte-swaps it into the reversed 74HC595 frame, displayDmaWrite4()
+ *              splits it into the per-digit BSRR words.
+ *
+ *              - **Pair tables**: `display_pair_decimal` holds the two codes of
+ *                every value 00..99 and `display_pair_hex` those of every byte
+ *                00..FF, as 16-bit halves of a packed word. They are generated
+ *                at compile time from the same glyphs and DISPLAY_FONT_CODE as
+ *                `display_font`, so they follow `DISPLAY_POLARITY`.
+ *
+ *              - **Packing**: a 4-digit decimal or hexadecimal word is two pair
+ *                loads and one ORR, with no per-digit lookup and no division.
+ *
+ *              | Function             | Instructions                          | Cycles |
+ *              |----------------------|---------------------------------------|--------|
+ *              | displayPackHex4      | UBFX, UXTB, 2x LDRH, ORR lsl          | ~7     |
+ *              | displayPackDecimal4  | CMP, MUL, LSR, MLS, 2x LDRH, ORR, IT  | ~12    |
+ *
+ *              Leading zeros are shown. The tables take 200 + 512 bytes of flash.
+ *
+ *  @file       display_packed.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef DISPLAY_PACKED_H_
+#define DISPLAY_PACKED_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "display_segments.h"
+#include "mem_placement.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def DISPLAY_PACKED_DIGITS
+ * @package    display_packed
+ * @brief Segment codes held by one packed word.
+ */
+#define DISPLAY_PACKED_DIGITS       (uint8_t)(4U)
+
+/**
+ * @def MAX_DISPLAY_PAIR_DECIMAL
+ * @package    display_packed
+ * @brief Number of entries of the decimal pair table, 00..99.
+ */
+#define MAX_DISPLAY_PAIR_DECIMAL    (uint8_t)(100U)
+
+/**
+ * @def MAX_DISPLAY_PAIR_HEX
+ * @package    display_packed
+ * @brief Number of entries of the hexadecimal pair table, 00..FF.
+ */
+#define MAX_DISPLAY_PAIR_HEX        (uint16_t)(256U)
+
+/**
+ * @def DISPLAY_PACKED_MAX_DECIMAL
+ * @package    display_packed
+ * @brief Largest value shown by displayPackDecimal4().
+ */
+#define DISPLAY_PACKED_MAX_DECIMAL  (uint16_t)(9999U)
+
+/**
+ * @def DISPLAY_PACKED_RECIP100
+ * @package    display_packed
+ * @brief 2^19 / 100 rounded up; `(value * 5243) >> 19` is value / 100 for
+ *        every value up to DISPLAY_PACKED_MAX_DECIMAL.
+ */
+#define DISPLAY_PACKED_RECIP100     (uint32_t)(5243U)
+
+/**
+ * @def DISPLAY_PACKED_SHIFT100
+ * @package    display_packed
+ * @brief Shift applied after the multiply by DISPLAY_PACKED_RECIP100.
+ */
+#define DISPLAY_PACKED_SHIFT100     (uint32_t)(19U)
+
+/*==========================================
+ *             Private Macros
+ * ========================================== */
+
+/**
+ * @def DISPLAY_PACK4
+ * @package    display_packed
+ * @brief Packs four segment codes, `c0` being the leftmost digit.
+ */
+#define DISPLAY_PACK4(c0, c1, c2, c3)                                          \
+    (uint32_t)((uint32_t)(uint8_t)(c0)          |                              \
+               ((uint32_t)(uint8_t)(c1) << 8u)  |                              \
+               ((uint32_t)(uint8_t)(c2) << 16u) |                              \
+               ((uint32_t)(uint8_t)(c3) << 24u))
+
+/**
+ * @def DISPLAY_PACKED_BLANK
+ * @package    display_packed
+ * @brief Packed word of four blank digits.
+ */
+#define DISPLAY_PACKED_BLANK        DISPLAY_PACK4(DISPLAY_CODE_BLANK, DISPLAY_CODE_BLANK, \
+                                                  DISPLAY_CODE_BLANK, DISPLAY_CODE_BLANK)
+
+/**
+ * @def DISPLAY_PACKED_OVERFLOW
+ * @package    display_packed
+ * @brief Packed word "----", shown for a value that does not fit.
+ */
+#define DISPLAY_PACKED_OVERFLOW     DISPLAY_PACK4(DISPLAY_FONT_CODE(DISPLAY_GLYPH_MINUS), \
+                                                  DISPLAY_FONT_CODE(DISPLAY_GLYPH_MINUS), \
+                                                  DISPLAY_FONT_CODE(DISPLAY_GLYPH_MINUS), \
+                                                  DISPLAY_FONT_CODE(DISPLAY_GLYPH_MINUS))
+
+/**
+ * @def DISPLAY_PAIR
+ * @package    display_packed
+ * @brief Codes of the glyphs `left` and `right` as the low half of a packed word.
+ *
+ * @details `DISPLAY_PAIR_DEC_ROW` and `DISPLAY_PAIR_HEX_ROW` expand a whole
+ *          row of pairs sharing their left digit, so both tables are produced
+ *          by the preprocessor.
+ */
+#define DISPLAY_PAIR(left, right)                                              \
+    (uint16_t)((uint32_t)DISPLAY_FONT_CODE(DISPLAY_GLYPH_##left) |             \
+               ((uint32_t)DISPLAY_FONT_CODE(DISPLAY_GLYPH_##right) << 8u))
+
+#define DISPLAY_PAIR_DEC_ROW(left)                                             \
+    DISPLAY_PAIR(left, 0), DISPLAY_PAIR(left, 1), DISPLAY_PAIR(left, 2),       \
+    DISPLAY_PAIR(left, 3), DISPLAY_PAIR(left, 4), DISPLAY_PAIR(left, 5),       \
+    DISPLAY_PAIR(left, 6), DISPLAY_PAIR(left, 7), DISPLAY_PAIR(left, 8),       \
+    DISPLAY_PAIR(left, 9)
+
+#define DISPLAY_PAIR_HEX_ROW(left)                                             \
+    DISPLAY_PAIR_DEC_ROW(left),                                                \
+    DISPLAY_PAIR(left, A), DISPLAY_PAIR(left, B), DISPLAY_PAIR(left, C),       \
+    DISPLAY_PAIR(left, D), DISPLAY_PAIR(left, E), DISPLAY_PAIR(left, F)
+
+/*==========================================
+ *         Private Global Variables
+ * ========================================== */
+
+/**
+ *  @var display_pair_decimal
+ *  @package    display_packed
+ *
+ *  @brief  Segment codes of the two digits of every value 00..99.
+ *
+ *  @details
+ *  Low byte: tens, high byte: units.
+ */
+const uint16_t display_pair_decimal[MAX_DISPLAY_PAIR_DECIMAL] __attribute__((weak, used, aligned(4))) MEM_TABLE_SECTION =
+{
+    DISPLAY_PAIR_DEC_ROW(0), DISPLAY_PAIR_DEC_ROW(1), DISPLAY_PAIR_DEC_ROW(2),
+    DISPLAY_PAIR_DEC_ROW(3), DISPLAY_PAIR_DEC_ROW(4), DISPLAY_PAIR_DEC_ROW(5),
+    DISPLAY_PAIR_DEC_ROW(6), DISPLAY_PAIR_DEC_ROW(7), DISPLAY_PAIR_DEC_ROW(8),
+    DISPLAY_PAIR_DEC_ROW(9)
+};
+
+/**
+ *  @var display_pair_hex
+ *  @package    display_packed
+ *
+ *  @brief  Segment codes of the two hexadecimal digits of every byte.
+ *
+ *  @details
+ *  Low byte: high nibble, high byte: low nibble.
+ */
+const uint16_t display_pair_hex[MAX_DISPLAY_PAIR_HEX] __attribute__((weak, used, aligned(4))) MEM_TABLE_SECTION =
+{
+    DISPLAY_PAIR_HEX_ROW(0), DISPLAY_PAIR_HEX_ROW(1), DISPLAY_PAIR_HEX_ROW(2),
+    DISPLAY_PAIR_HEX_ROW(3), DISPLAY_PAIR_HEX_ROW(4), DISPLAY_PAIR_HEX_ROW(5),
+    DISPLAY_PAIR_HEX_ROW(6), DISPLAY_PAIR_HEX_ROW(7), DISPLAY_PAIR_HEX_ROW(8),
+    DISPLAY_PAIR_HEX_ROW(9), DISPLAY_PAIR_HEX_ROW(A), DISPLAY_PAIR_HEX_ROW(B),
+    DISPLAY_PAIR_HEX_ROW(C), DISPLAY_PAIR_HEX_ROW(D), DISPLAY_PAIR_HEX_ROW(E),
+    DISPLAY_PAIR_HEX_ROW(F)
+};
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         displayPackFont4
+ *  @package    display_packed
+ *
+ *  @brief      Packs four characters through `display_font`.
+ *
+ *  @details    Meant for text built once, e.g. a label set at init time. Hot
+ *              paths use the pair tables or DISPLAY_PACK4 on constants.
+ *
+ *  @param      text [in] : Four characters, the leftmost first.
+ *
+ *  @return     The packed word.
+ */
+static inline uint32_t displayPackFont4(const char text[DISPLAY_PACKED_DIGITS])
+{
+    return DISPLAY_PACK4(displayFontLookup(text[0]), displayFontLookup(text[1]),
+                         displayFontLookup(text[2]), displayFontLookup(text[3]));
+}
+
+/**
+ *  @fn         displayPackHex4
+ *  @package    display_packed
+ *
+ *  @brief      Packs a 16-bit value as four hexadecimal digits.
+ *
+ *  @param      value [in] : Value to be shown.
+ *
+ *  @return     The packed word, most significant nibble on the left.
+ */
+static inline uint32_t displayPackHex4(uint16_t value)
+{
+    return ((uint32_t)display_pair_hex[value >> 8u] |
+            ((uint32_t)display_pair_hex[value & 0xFFu] << 16u));
+}
+
+/**
+ *  @fn         displayPackDecimal4
+ *  @package    display_packed
+ *
+ *  @brief      Packs a value 0..9999 as four decimal digits.
+ *
+ *  @details    Splits the value into hundreds and units with one multiply by
+ *              the reciprocal of 100, then loads one pair for each half. A
+ *              larger value gives DISPLAY_PACKED_OVERFLOW through a select.
+ *
+ *  @param      value [in] : Value to be shown.
+ *
+ *  @return     The packed word, or DISPLAY_PACKED_OVERFLOW above 9999.
+ */
+static inline uint32_t displayPackDecimal4(uint16_t value)
+{
+    uint32_t clamped  = (value > DISPLAY_PACKED_MAX_DECIMAL) ? 0u : value;
+    uint32_t hundreds = ((clamped * DISPLAY_PACKED_RECIP100) >> DISPLAY_PACKED_SHIFT100);
+    uint32_t units    = (clamped - (hundreds * 100u));
+
+    uint32_t word = ((uint32_t)display_pair_decimal[hundreds] |
+                     ((uint32_t)display_pair_decimal[units] << 16u));
+
+    return (value > DISPLAY_PACKED_MAX_DECIMAL) ? DISPLAY_PACKED_OVERFLOW : word;
+}
+
+/**
+ *  @fn         displayPackDigit
+ *  @package    display_packed
+ *
+ *  @brief      Segment code of one digit of a packed word.
+ *
+ *  @param      word  [in] : Packed word.
+ *  @param      digit [in] : Position in the word, 0 is the leftmost.
+ *
+ *  @return     The segment code.
+ */
+static inline uint8_t displayPackDigit(uint32_t word, uint8_t digit)
+{
+    return (uint8_t)(word >> (8u * digit));
+}
+
+#endif /* DISPLAY_PACKED_H_ */
+/* end of file */
@@ -19,15 +19,37 @@
  *                their respective ASCII characters for easy representation in
  *                character-based displays.
  *              
- *              - **Binary Code Mappings**: Arrays like `display_number`,
- *                `display_digit`, and `display_hexadecimal` map enums to specific
- *                binary codes used in 7-segment displays, where each bit corresponds
- *                to a particular segment of the display.
+ *              - **Segment Font**: `display_font` holds the 7-segment code of
+ *                every 7-bit ASCII character, so a character is turned into its
+ *                segment code with a single indexed load (displayFontLookup()).
+ *                Each glyph is defined only once, as a DISPLAY_GLYPH_* value.
  *
- *              - **Attributes**: The arrays are defined with attributes
- *                `__attribute__((weak, used, aligned(4)))` to allow for flexibility
- *                in overriding, ensure they are retained during compilation, and
- *                optimize memory alignment for performance.
+ *              - **Binary Code Mappings**: `display_number`, `display_digit`, and
+ *                `display_hexadecimal` are constant pointers into `display_font`,
+ *                indexed by the enums below. Each bit of a code corresponds to a
+ *                particular segment of the display. Being pointers, they are not
+ *                arrays any more: `sizeof` gives a pointer, and an `extern` array
+ *                declaration of them no longer matches. Use MAX_DISPLAY_NUM,
+ *                MAX_DISPLAY_DIG and MAX_DISPLAY_HEX for their lengths.
+ *
+ *              - **Size**: the font takes 128 bytes, where the three separate
+ *                code tables took 55 (11 + 27 + 17), so the codes cost 73 more
+ *                bytes of flash. In exchange, any character is one load and no
+ *                code is written twice. The three `*_char` tables are kept
+ *                as they are, 55 bytes.
+ *
+ *              - **Polarity**: `DISPLAY_POLARITY` selects common cathode (a lit
+ *                segment is '1') or common anode (a lit segment is '0') at build
+ *                time. The font is emitted already inverted for common anode, so
+ *                the refresh path does one load per digit whatever the polarity.
+ *
+ *              - **Attributes**: `display_font` and the `*_char` arrays are
+ *                defined with attributes `__attribute__((weak, used, aligned(4)))`
+ *                to allow for flexibility in overriding, ensure they are retained
+ *                during compilation, and optimize memory alignment for
+ *                performance. The code views follow an overridden font and can
+ *                not be overridden on their own. MEM_TABLE_SECTION moves the
+ *                arrays to CCM RAM or SRAM when selected (see mem_placement.h).
  *
  *  @file       display_segments.h
  * 
@@ -46,6 +68,9 @@
 /* Dependencies of libc */
 #include <stdint.h>
 
+/* Implementeds */
+#include "mem_placement.h"
+
 /*==========================================
  *             Private Defines
  * ========================================== */
@@ -77,6 +102,114 @@
  */
 #define MAX_DISPLAY_DIG             (uint8_t)(27U)
 
+/**
+ * @def MAX_DISPLAY_FONT
+ * @package    display_segments
+ * @brief Number of entries of the segment font, one per 7-bit ASCII character.
+ */
+#define MAX_DISPLAY_FONT            (uint8_t)(128U)
+
+/**
+ * @def DISPLAY_FONT_ASCII_MASK
+ * @package    display_segments
+ * @brief Keeps a character inside the 7-bit ASCII range of the font.
+ */
+#define DISPLAY_FONT_ASCII_MASK     (uint8_t)(0x7FU)
+
+/**
+ * @def DISPLAY_FONT_NUM_BASE
+ * @package    display_segments
+ * @brief Font index of DISPLAY_NUM_0.
+ *
+ * @details '0'..'9' are followed by ':', kept blank, which serves as
+ *          DISPLAY_NUM_NULL.
+ */
+#define DISPLAY_FONT_NUM_BASE       (uint8_t)('0')
+
+/**
+ * @def DISPLAY_FONT_DIG_BASE
+ * @package    display_segments
+ * @brief Font index of DISPLAY_DIG_A.
+ *
+ * @details 'A'..'Z' are followed by '[', kept blank, which serves as
+ *          DISPLAY_DIG_NULL.
+ */
+#define DISPLAY_FONT_DIG_BASE       (uint8_t)('A')
+
+/**
+ * @def DISPLAY_FONT_HEX_BASE
+ * @package    display_segments
+ * @brief Font index of DISPLAY_HEX_0.
+ *
+ * @details The ASCII digits and letters are not contiguous, so the hexadecimal
+ *          view uses the unprintable slots 0x10..0x1F. They are followed by
+ *          ' ', which is blank and serves as DISPLAY_HEX_NULL.
+ */
+#define DISPLAY_FONT_HEX_BASE       (uint8_t)(0x10U)
+
+/* Display polarities, kept as plain literals so they can be tested by #if */
+#define DISPLAY_COMMON_CATHODE      0u
+#define DISPLAY_COMMON_ANODE        1u
+
+/**
+ * @def DISPLAY_POLARITY
+ * @package    display_segments
+ * @brief Polarity the font is generated for.
+ *
+ * @details Defaults to common cathode, matching the codes of DISPLAY_GLYPH_*.
+ */
+#ifndef DISPLAY_POLARITY
+#define DISPLAY_POLARITY            DISPLAY_COMMON_CATHODE
+#endif
+
+/**
+ * @def DISPLAY_GLYPH_0
+ * @package    display_segments
+ * @brief Segment codes of every glyph, bit 0 is segment a and bit 6 segment g.
+ *
+ * @details Each glyph is written once here and only referenced by the font.
+ */
+#define DISPLAY_GLYPH_0             (uint8_t)(0b00111111)  /**< Segments of '0' */
+#define DISPLAY_GLYPH_1             (uint8_t)(0b00000110)  /**< Segments of '1' */
+#define DISPLAY_GLYPH_2             (uint8_t)(0b01011011)  /**< Segments of '2' */
+#define DISPLAY_GLYPH_3             (uint8_t)(0b01001111)  /**< Segments of '3' */
+#define DISPLAY_GLYPH_4             (uint8_t)(0b01100110)  /**< Segments of '4' */
+#define DISPLAY_GLYPH_5             (uint8_t)(0b01101101)  /**< Segments of '5' */
+#define DISPLAY_GLYPH_6             (uint8_t)(0b01111101)  /**< Segments of '6' */
+#define DISPLAY_GLYPH_7             (uint8_t)(0b00000111)  /**< Segments of '7' */
+#define DISPLAY_GLYPH_8             (uint8_t)(0b01111111)  /**< Segments of '8' */
+#define DISPLAY_GLYPH_9             (uint8_t)(0b01101111)  /**< Segments of '9' */
+#define DISPLAY_GLYPH_A             (uint8_t)(0b01110111)  /**< Segments of 'A' */
+#define DISPLAY_GLYPH_B             (uint8_t)(0b01111100)  /**< Segments of 'B' */
+#define DISPLAY_GLYPH_C             (uint8_t)(0b00111001)  /**< Segments of 'C' */
+#define DISPLAY_GLYPH_D             (uint8_t)(0b01011110)  /**< Segments of 'D' */
+#define DISPLAY_GLYPH_E             (uint8_t)(0b01111001)  /**< Segments of 'E' */
+#define DISPLAY_GLYPH_F             (uint8_t)(0b01110001)  /**< Segments of 'F' */
+#define DISPLAY_GLYPH_G             (uint8_t)(0b00111101)  /**< Segments of 'G' */
+#define DISPLAY_GLYPH_H             (uint8_t)(0b01110100)  /**< Segments of 'H' */
+#define DISPLAY_GLYPH_I             (uint8_t)(0b00110000)  /**< Segments of 'I' */
+#define DISPLAY_GLYPH_J             (uint8_t)(0b00011110)  /**< Segments of 'J' */
+#define DISPLAY_GLYPH_K             (uint8_t)(0b01110101)  /**< Segments of 'K' */
+#define DISPLAY_GLYPH_L             (uint8_t)(0b00111000)  /**< Segments of 'L' */
+#define DISPLAY_GLYPH_M             (uint8_t)(0b00010101)  /**< Segments of 'M' */
+#define DISPLAY_GLYPH_N             (uint8_t)(0b00110111)  /**< Segments of 'N' */
+#define DISPLAY_GLYPH_O             (uint8_t)(0b00111111)  /**< Segments of 'O' */
+#define DISPLAY_GLYPH_P             (uint8_t)(0b01110011)  /**< Segments of 'P' */
+#define DISPLAY_GLYPH_Q             (uint8_t)(0b01100111)  /**< Segments of 'Q' */
+#define DISPLAY_GLYPH_R             (uint8_t)(0b00110011)  /**< Segments of 'R' */
+#define DISPLAY_GLYPH_S             (uint8_t)(0b01101101)  /**< Segments of 'S' */
+#define DISPLAY_GLYPH_T             (uint8_t)(0b01111000)  /**< Segments of 'T' */
+#define DISPLAY_GLYPH_U             (uint8_t)(0b00111110)  /**< Segments of 'U' */
+#define DISPLAY_GLYPH_V             (uint8_t)(0b00011100)  /**< Segments of 'V' */
+#define DISPLAY_GLYPH_W             (uint8_t)(0b00101010)  /**< Segments of 'W' */
+#define DISPLAY_GLYPH_X             (uint8_t)(0b00110110)  /**< Segments of 'X' */
+#define DISPLAY_GLYPH_Y             (uint8_t)(0b01101110)  /**< Segments of 'Y' */
+#define DISPLAY_GLYPH_Z             (uint8_t)(0b01011011)  /**< Segments of 'Z' */
+#define DISPLAY_GLYPH_BLANK         (uint8_t)(0b00000000)  /**< Segments of ' ' and unmapped characters */
+#define DISPLAY_GLYPH_MINUS         (uint8_t)(0b01000000)  /**< Segments of '-' */
+#define DISPLAY_GLYPH_UNDERSCORE    (uint8_t)(0b00001000)  /**< Segments of '_' */
+#define DISPLAY_GLYPH_EQUAL         (uint8_t)(0b01001000)  /**< Segments of '=' */
+
 
 /*==========================================
  *             Private Macros
@@ -93,7 +226,7 @@
  * 
  * @return The inverted binary value as an 8-bit unsigned integer.
  */
-#define COMMUN_ANODE(binary_value)  (uint8_t)(!(binary_value))
+#define COMMUN_ANODE(binary_value)  (uint8_t)(~(binary_value))
 
 /**
  * @def COMMUN_CATODE
@@ -108,6 +241,31 @@
  */
 #define COMMUN_CATODE(binary_value) (uint8_t)(binary_value)
 
+/**
+ * @def DISPLAY_FONT_CODE
+ * @package    display_segments
+ * @brief Converts a glyph into the code stored in the font for `DISPLAY_POLARITY`.
+ *
+ * @details Expands to COMMUN_ANODE or COMMUN_CATODE, so the inversion happens
+ *          once at compile time and never on the refresh path.
+ *
+ * @param glyph The DISPLAY_GLYPH_* value to be converted.
+ *
+ * @return The segment code as stored in `display_font`.
+ */
+#if (DISPLAY_POLARITY == DISPLAY_COMMON_ANODE)
+#define DISPLAY_FONT_CODE(glyph)    COMMUN_ANODE(glyph)
+#else
+#define DISPLAY_FONT_CODE(glyph)    COMMUN_CATODE(glyph)
+#endif
+
+/**
+ * @def DISPLAY_CODE_BLANK
+ * @package    display_segments
+ * @brief Code of a digit with every segment off, for the selected polarity.
+ */
+#define DISPLAY_CODE_BLANK          DISPLAY_FONT_CODE(DISPLAY_GLYPH_BLANK)
+
 /*==========================================
  *              Private Types
  * ========================================== */
@@ -204,6 +362,109 @@ typedef enum __attribute__((aligned(1))) displayHexadecimal
  *         Private Global Variables
  * ========================================== */
 
+/**
+ *  @var display_font
+ *  @package    display_segments
+ *
+ *  @brief  Mapping of 7-bit ASCII characters to 7-segment display binary codes.
+ *
+ *  @details
+ *  This constant defines the only segment code table of the module. It is
+ *  indexed directly by a character, and the `display_number`, `display_digit`
+ *  and `display_hexadecimal` views index it through the enumerations. Every
+ *  entry starts blank and is then overridden by the glyphs listed below; the
+ *  view NULL slots stay blank. All entries go through DISPLAY_FONT_CODE, so
+ *  the table is emitted pre-inverted for common anode builds.
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverride-init"
+const uint8_t display_font[MAX_DISPLAY_FONT] __attribute__((weak, used, aligned(4))) MEM_TABLE_SECTION =
+{
+    [0 ... (MAX_DISPLAY_FONT - 1u)]   = DISPLAY_CODE_BLANK,
+    ['0']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_0),
+    ['1']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_1),
+    ['2']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_2),
+    ['3']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_3),
+    ['4']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_4),
+    ['5']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_5),
+    ['6']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_6),
+    ['7']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_7),
+    ['8']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_8),
+    ['9']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_9),
+    ['A']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_A),
+    ['B']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_B),
+    ['C']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_C),
+    ['D']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_D),
+    ['E']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_E),
+    ['F']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_F),
+    ['G']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_G),
+    ['H']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_H),
+    ['I']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_I),
+    ['J']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_J),
+    ['K']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_K),
+    ['L']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_L),
+    ['M']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_M),
+    ['N']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_N),
+    ['O']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_O),
+    ['P']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_P),
+    ['Q']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_Q),
+    ['R']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_R),
+    ['S']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_S),
+    ['T']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_T),
+    ['U']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_U),
+    ['V']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_V),
+    ['W']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_W),
+    ['X']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_X),
+    ['Y']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_Y),
+    ['Z']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_Z),
+    ['a']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_A),
+    ['b']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_B),
+    ['c']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_C),
+    ['d']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_D),
+    ['e']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_E),
+    ['f']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_F),
+    ['g']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_G),
+    ['h']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_H),
+    ['i']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_I),
+    ['j']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_J),
+    ['k']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_K),
+    ['l']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_L),
+    ['m']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_M),
+    ['n']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_N),
+    ['o']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_O),
+    ['p']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_P),
+    ['q']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_Q),
+    ['r']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_R),
+    ['s']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_S),
+    ['t']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_T),
+    ['u']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_U),
+    ['v']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_V),
+    ['w']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_W),
+    ['x']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_X),
+    ['y']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_Y),
+    ['z']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_Z),
+    [DISPLAY_FONT_HEX_BASE + 0x0]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_0),
+    [DISPLAY_FONT_HEX_BASE + 0x1]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_1),
+    [DISPLAY_FONT_HEX_BASE + 0x2]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_2),
+    [DISPLAY_FONT_HEX_BASE + 0x3]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_3),
+    [DISPLAY_FONT_HEX_BASE + 0x4]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_4),
+    [DISPLAY_FONT_HEX_BASE + 0x5]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_5),
+    [DISPLAY_FONT_HEX_BASE + 0x6]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_6),
+    [DISPLAY_FONT_HEX_BASE + 0x7]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_7),
+    [DISPLAY_FONT_HEX_BASE + 0x8]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_8),
+    [DISPLAY_FONT_HEX_BASE + 0x9]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_9),
+    [DISPLAY_FONT_HEX_BASE + 0xA]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_A),
+    [DISPLAY_FONT_HEX_BASE + 0xB]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_B),
+    [DISPLAY_FONT_HEX_BASE + 0xC]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_C),
+    [DISPLAY_FONT_HEX_BASE + 0xD]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_D),
+    [DISPLAY_FONT_HEX_BASE + 0xE]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_E),
+    [DISPLAY_FONT_HEX_BASE + 0xF]     = DISPLAY_FONT_CODE(DISPLAY_GLYPH_F),
+    ['-']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_MINUS),
+    ['_']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_UNDERSCORE),
+    ['=']                             = DISPLAY_FONT_CODE(DISPLAY_GLYPH_EQUAL)
+};
+#pragma GCC diagnostic pop
+
 /**
  *  @var display_number_char
  *  @package    display_segments
@@ -215,7 +476,7 @@ typedef enum __attribute__((aligned(1))) displayHexadecimal
  *  `display_numbers_t` enumeration to its corresponding character. Used for
  *  displaying numbers as characters.
  */
-const char display_number_char[MAX_DISPLAY_NUM] __attribute__((weak, used, aligned(4))) =
+const char display_number_char[MAX_DISPLAY_NUM] __attribute__((weak, used, aligned(4))) MEM_TABLE_SECTION =
 {
     [DISPLAY_NUM_0]     = '0',    /**< Character for number 0 */
     [DISPLAY_NUM_1]     = '1',    /**< Character for number 1 */
@@ -237,24 +498,11 @@ const char display_number_char[MAX_DISPLAY_NUM] __attribute__((weak, used, align
  *  @brief  Mapping of numbers to 7-segment display binary codes.
  *
  *  @details
- *  This constant defines an array of `uint8_t` that maps each value of the
- *  `display_numbers_t` enumeration to its corresponding binary code used in
- *  7-segment displays. Each bit represents a specific segment of the display.
+ *  Constant pointer into `display_font` indexed by the `display_numbers_t`
+ *  enumeration, e.g. `display_number[DISPLAY_NUM_7]`. Each bit represents a
+ *  specific segment of the display.
  */
-const uint8_t display_number[MAX_DISPLAY_NUM] __attribute__((weak, used, aligned(4))) =
-{
-    [DISPLAY_NUM_0]     = 0b00111111, /**< Binary code for number 0 */
-    [DISPLAY_NUM_1]     = 0b00000110, /**< Binary code for number 1 */
-    [DISPLAY_NUM_2]     = 0b01011011, /**< Binary code for number 2 */
-    [DISPLAY_NUM_3]     = 0b01001111, /**< Binary code for number 3 */
-    [DISPLAY_NUM_4]     = 0b01100110, /**< Binary code for number 4 */
-    [DISPLAY_NUM_5]     = 0b01101101, /**< Binary code for number 5 */
-    [DISPLAY_NUM_6]     = 0b01111101, /**< Binary code for number 6 */
-    [DISPLAY_NUM_7]     = 0b00000111, /**< Binary code for number 7 */
-    [DISPLAY_NUM_8]     = 0b01111111, /**< Binary code for number 8 */
-    [DISPLAY_NUM_9]     = 0b01101111, /**< Binary code for number 9 */
-    [DISPLAY_NUM_NULL]  = 0b00000000  /**< Null binary code */
-};
+static const uint8_t *const display_number = &display_font[DISPLAY_FONT_NUM_BASE];
 
 /**
  *  @var display_digit_char
@@ -267,7 +515,7 @@ const uint8_t display_number[MAX_DISPLAY_NUM] __attribute__((weak, used, aligned
  *  `display_digits_t` enumeration to its corresponding alphabetical character.
  *  Used for displaying letters as characters.
  */
-const char display_digit_char[MAX_DISPLAY_DIG] __attribute__((weak, used, aligned(4))) =
+const char display_digit_char[MAX_DISPLAY_DIG] __attribute__((weak, used, aligned(4))) MEM_TABLE_SECTION =
 {
     [DISPLAY_DIG_A]     = 'A',    /**< Character for digit A */
     [DISPLAY_DIG_B]     = 'B',    /**< Character for digit B */
@@ -305,40 +553,11 @@ const char display_digit_char[MAX_DISPLAY_DIG] __attribute__((weak, used, aligne
  *  @brief  Mapping of alphabetical digits to 7-segment display binary codes.
  *
  *  @details
- *  This constant defines an array of `uint8_t` that maps each value of the
- *  `display_digits_t` enumeration to its corresponding binary code used in
- *  7-segment displays. Each bit represents a specific segment of the display.
+ *  Constant pointer into `display_font` indexed by the `display_digits_t`
+ *  enumeration, e.g. `display_digit[DISPLAY_DIG_H]`. Each bit represents a
+ *  specific segment of the display.
  */
-const uint8_t display_digit[MAX_DISPLAY_DIG] __attribute__((weak, used, aligned(4))) =
-{
-    [DISPLAY_DIG_A]     = 0b01110111, /**< Binary code for digit A */
-    [DISPLAY_DIG_B]     = 0b01111100, /**< Binary code for digit B */
-    [DISPLAY_DIG_C]     = 0b00111001, /**< Binary code for digit C */
-    [DISPLAY_DIG_D]     = 0b01011110, /**< Binary code for digit D */
-    [DISPLAY_DIG_E]     = 0b01111001, /**< Binary code for digit E */
-    [DISPLAY_DIG_F]     = 0b01110001, /**< Binary code for digit F */
-    [DISPLAY_DIG_G]     = 0b00111101, /**< Binary code for digit G */
-    [DISPLAY_DIG_H]     = 0b01110100, /**< Binary code for digit H */
-    [DISPLAY_DIG_I]     = 0b00110000, /**< Binary code for digit I */
-    [DISPLAY_DIG_J]     = 0b00011110, /**< Binary code for digit J */
-    [DISPLAY_DIG_K]     = 0b01110101, /**< Binary code for digit K */
-    [DISPLAY_DIG_L]     = 0b00111000, /**< Binary code for digit L */
-    [DISPLAY_DIG_M]     = 0b00010101, /**< Binary code for digit M */
-    [DISPLAY_DIG_N]     = 0b00110111, /**< Binary code for digit N */
-    [DISPLAY_DIG_O]     = 0b00111111, /**< Binary code for digit O */
-    [DISPLAY_DIG_P]     = 0b01110011, /**< Binary code for digit P */
-    [DISPLAY_DIG_Q]     = 0b01100111, /**< Binary code for digit Q */
-    [DISPLAY_DIG_R]     = 0b00110011, /**< Binary code for digit R */
-    [DISPLAY_DIG_S]     = 0b01101101, /**< Binary code for digit S */
-    [DISPLAY_DIG_T]     = 0b01111000, /**< Binary code for digit T */
-    [DISPLAY_DIG_U]     = 0b00111110, /**< Binary code for digit U */
-    [DISPLAY_DIG_V]     = 0b00011100, /**< Binary code for digit V */
-    [DISPLAY_DIG_W]     = 0b00101010, /**< Binary code for digit W */
-    [DISPLAY_DIG_X]     = 0b00110110, /**< Binary code for digit X */
-    [DISPLAY_DIG_Y]     = 0b01101110, /**< Binary code for digit Y */
-    [DISPLAY_DIG_Z]     = 0b01011011, /**< Binary code for digit Z */
-    [DISPLAY_DIG_NULL]  = 0b00000000  /**< Null binary code */
-};
+static const uint8_t *const display_digit = &display_font[DISPLAY_FONT_DIG_BASE];
 
 /**
  *  @var display_hexadecimal_char
@@ -351,7 +570,7 @@ const uint8_t display_digit[MAX_DISPLAY_DIG] __attribute__((weak, used, aligned(
  *  `display_hex_t` enumeration to its corresponding hexadecimal character. Used
  *  for displaying hexadecimal values as characters.
  */
-const char display_hexadecimal_char[MAX_DISPLAY_HEX] __attribute__((weak, used, aligned(4))) =
+const char display_hexadecimal_char[MAX_DISPLAY_HEX] __attribute__((weak, used, aligned(4))) MEM_TABLE_SECTION =
 {
     [DISPLAY_HEX_0]     = '0',    /**< Character for hexadecimal 0 */
     [DISPLAY_HEX_1]     = '1',    /**< Character for hexadecimal 1 */
@@ -379,30 +598,33 @@ const char display_hexadecimal_char[MAX_DISPLAY_HEX] __attribute__((weak, used,
  *  @brief  Mapping of hexadecimal values to 7-segment display binary codes.
  *
  *  @details
- *  This constant defines an array of `uint8_t` that maps each value of the
- *  `display_hex_t` enumeration to its corresponding binary code used in
- *  7-segment displays. Each bit represents a specific segment of the display.
+ *  Constant pointer into `display_font` indexed by the `display_hex_t`
+ *  enumeration, e.g. `display_hexadecimal[DISPLAY_HEX_A]`. Each bit represents a
+ *  specific segment of the display.
+ */
+static const uint8_t *const display_hexadecimal = &display_font[DISPLAY_FONT_HEX_BASE];
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         displayFontLookup
+ *  @package    display_segments
+ *
+ *  @brief      Returns the 7-segment code of a character.
+ *
+ *  @details    One masked, indexed load. Lowercase letters share the uppercase
+ *              glyphs and characters without a glyph are blank.
+ *
+ *  @param      character [in] : Character to be shown.
+ *
+ *  @return     The segment code of the character.
  */
-const uint8_t display_hexadecimal[MAX_DISPLAY_HEX] __attribute__((weak, used, aligned(4))) =
+static inline uint8_t displayFontLookup(char character)
 {
-    [DISPLAY_HEX_0]     = 0b00111111, /**< Binary code for hexadecimal 0 */
-    [DISPLAY_HEX_1]     = 0b00000110, /**< Binary code for hexadecimal 1 */
-    [DISPLAY_HEX_2]     = 0b01011011, /**< Binary code for hexadecimal 2 */
-    [DISPLAY_HEX_3]     = 0b01001111, /**< Binary code for hexadecimal 3 */
-    [DISPLAY_HEX_4]     = 0b01100110, /**< Binary code for hexadecimal 4 */
-    [DISPLAY_HEX_5]     = 0b01101101, /**< Binary code for hexadecimal 5 */
-    [DISPLAY_HEX_6]     = 0b01111101, /**< Binary code for hexadecimal 6 */
-    [DISPLAY_HEX_7]     = 0b00000111, /**< Binary code for hexadecimal 7 */
-    [DISPLAY_HEX_8]     = 0b01111111, /**< Binary code for hexadecimal 8 */
-    [DISPLAY_HEX_9]     = 0b01101111, /**< Binary code for hexadecimal 9 */
-    [DISPLAY_HEX_A]     = 0b01110111, /**< Binary code for hexadecimal A */
-    [DISPLAY_HEX_B]     = 0b01111100, /**< Binary code for hexadecimal B */
-    [DISPLAY_HEX_C]     = 0b00111001, /**< Binary code for hexadecimal C */
-    [DISPLAY_HEX_D]     = 0b01011110, /**< Binary code for hexadecimal D */
-    [DISPLAY_HEX_E]     = 0b01111001, /**< Binary code for hexadecimal E */
-    [DISPLAY_HEX_F]     = 0b01110001, /**< Binary code for hexadecimal F */
-    [DISPLAY_HEX_NULL]  = 0b00000000  /**< Null binary code */
-};
+    return display_font[(uint8_t)character & DISPLAY_FONT_ASCII_MASK];
+}
 
 #endif /* DISPLAY_SEGMENTS_H_ */
 /* end of file */
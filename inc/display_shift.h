@@ -0,0 +1,386 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes display_shift
+ *
+ *  @package    display_shift
+ *  @brief      This module provides a zero-CPU output backend that streams the
+ *              `display_segments.h` codes to daisy-chained 74HC595 registers
+ *              over SPI, paced and latched by a timer through DMA2.
+ *
+ *  @details    Each digit has its own 74HC595 driving its 8 segment lines, so
+ *              the display is static: no multiplexing, no ghosting, and
+ *              8..32 digits on three pins (SCK, MOSI and the RCLK latch).
+ *
+ *              - **Byte pacing**: the timer update request moves one frame
+ *                byte into SPIx->DR per period. The SPI only works as a
+ *                shifter; TXE is never used, so the DMA cannot outrun the
+ *                frame and the period fixes the refresh rate exactly.
+ *
+ *              - **Latch**: the CC1 request fires once the byte of the period
+ *                has been shifted out, and writes the next word of a circular
+ *                latch table into the latch port BSRR. Only the word that
+ *                follows the last byte of the frame raises RCLK; all the others
+ *                lower it. So the 74HC595 outputs switch once per frame, when
+ *                every register holds the new codes.
+ *
+ *              - **Updates**: the CPU only writes the frame byte of a digit
+ *                when its code changes. A partial frame can never be shown:
+ *                the latch always copies a full chain.
+ *
+ *              SPI1 (APB2) is the SPI reachable by DMA2 next to TIM1/TIM8:
+ *
+ *              | Timer | UP (frame bytes) | CH1 (latch)     |
+ *              |-------|------------------|-----------------|
+ *              | TIM1  | S5, ch 6         | S1 or S3, ch 6  |
+ *              | TIM8  | S1, ch 7         | S2, ch 7        |
+ *
+ *              The timer, SPI, DMA2 and GPIO clocks and the SCK/MOSI alternate
+ *              functions (e.g. through `gpio_pin.h`) have to be set up by the
+ *              caller before displayShiftInit() runs.
+ *
+ *  @file       display_shift.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef DISPLAY_SHIFT_H_
+#define DISPLAY_SHIFT_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+#include "gpio_pin.h"
+#include "display_segments.h"
+#include "display_dma.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def DISPLAY_SHIFT_MAX_DIGITS
+ * @package    display_shift
+ * @brief Maximum number of chained 74HC595, one per digit.
+ */
+#define DISPLAY_SHIFT_MAX_DIGITS    (uint8_t)(32U)
+
+/**
+ * @def DISPLAY_SHIFT_FRAME_WORDS
+ * @package    display_shift
+ * @brief Words of the frame buffer, four digits each.
+ */
+#define DISPLAY_SHIFT_FRAME_WORDS   (uint8_t)(DISPLAY_SHIFT_MAX_DIGITS / 4U)
+
+/**
+ * @def DISPLAY_SHIFT_MIN_DIGITS
+ * @package    display_shift
+ * @brief Minimum chain length, the latch needs one rising and one falling slot.
+ */
+#define DISPLAY_SHIFT_MIN_DIGITS    (uint8_t)(2U)
+
+/**
+ * @def DISPLAY_SHIFT_BYTE_CLOCKS
+ * @package    display_shift
+ * @brief SPI kernel clocks per byte at baud field 0, i.e. 8 bits of PCLK / 2.
+ */
+#define DISPLAY_SHIFT_BYTE_CLOCKS   (uint32_t)(16U)
+
+/**
+ * @def DISPLAY_SHIFT_DMA_MARGIN
+ * @package    display_shift
+ * @brief Timer kernel clocks allowed for the update beat to reach SPIx->DR.
+ */
+#define DISPLAY_SHIFT_DMA_MARGIN    (uint32_t)(16U)
+
+/**
+ * @def DISPLAY_SHIFT_BAUD_MAX
+ * @package    display_shift
+ * @brief Largest SPI_CR1 BR field, PCLK / 256.
+ */
+#define DISPLAY_SHIFT_BAUD_MAX      (uint8_t)(7U)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    displayShiftStatus
+ *  @typedef display_shift_status_t
+ *  @package    display_shift
+ *
+ *  @brief   Result of the backend configuration.
+ */
+typedef enum displayShiftStatus
+{
+    DISPLAY_SHIFT_OK        = (uint8_t)(0u),    /**< Chain being refreshed */
+    DISPLAY_SHIFT_INVALID   = (uint8_t)(1u)     /**< Rejected configuration */
+} display_shift_status_t;
+
+/**
+ *  @struct  displayShiftConfig
+ *  @typedef display_shift_config_t
+ *  @package    display_shift
+ *
+ *  @brief   Chain, SPI, timer and DMA resources of a 74HC595 display.
+ *
+ *  @details The SPI runs in mode 0, MSB first: bit 7 of a code ends on QH.
+ */
+typedef struct displayShiftConfig
+{
+    TIM_TypeDef         *timer;             /**< TIM1 or TIM8, one period per byte */
+    uint32_t             timer_clock_hz;    /**< Timer kernel clock */
+    uint32_t             refresh_hz;        /**< Full chain transfers per second */
+    SPI_TypeDef         *spi;               /**< SPI shifting the bytes, SPI1 */
+    uint32_t             spi_clock_hz;      /**< SPI kernel clock (PCLK2) */
+    uint8_t              spi_baud;          /**< SPI_CR1 BR field, SCK = PCLK / 2^(n + 1) */
+    GPIO_TypeDef        *latch_port;        /**< Port of the RCLK pin */
+    uint8_t              latch_pin;         /**< RCLK pin number */
+    uint8_t              digit_count;       /**< Chained registers, 2..DISPLAY_SHIFT_MAX_DIGITS */
+    DMA_TypeDef         *dma;               /**< DMA controller, must be DMA2 */
+    DMA_Stream_TypeDef  *data_stream;       /**< Stream serving the timer update request */
+    uint32_t             data_channel;      /**< Request channel of that stream */
+    DMA_Stream_TypeDef  *latch_stream;      /**< Stream serving the CH1 request */
+    uint32_t             latch_channel;     /**< Request channel of that stream */
+} display_shift_config_t;
+
+/**
+ *  @struct  displayShift
+ *  @typedef display_shift_t
+ *  @package    display_shift
+ *
+ *  @brief   Runtime state of a 74HC595 display.
+ *
+ *  @details `frame` is in shifting order: the first byte travels to the far end
+ *           of the chain. displayShiftWrite() and displayShiftWrite4() hide
+ *           that order; `frame_word` overlays `frame` for the latter.
+ */
+typedef struct displayShift
+{
+    TIM_TypeDef         *timer;                             /**< Pacing timer */
+    uint8_t              digit_count;                       /**< Chained registers */
+
+    union
+    {
+        volatile uint8_t  frame[DISPLAY_SHIFT_MAX_DIGITS];          /**< Update stream source */
+        volatile uint32_t frame_word[DISPLAY_SHIFT_FRAME_WORDS];    /**< Same bytes, four per word */
+    };
+
+    volatile uint32_t    latch[DISPLAY_SHIFT_MAX_DIGITS];   /**< CH1 stream source, RCLK BSRR words */
+} display_shift_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         displayShiftWrite
+ *  @package    display_shift
+ *
+ *  @brief      Sets the segment code shown on one digit.
+ *
+ *  @details    A single byte store, latched at the end of the next frame.
+ *
+ *  @param      shift [in] : Driver instance.
+ *  @param      digit [in] : Digit position, 0 is the register next to the MCU.
+ *  @param      code  [in] : Segment code, e.g. display_number[DISPLAY_NUM_7].
+ */
+static inline void displayShiftWrite(display_shift_t *shift, uint8_t digit, uint8_t code)
+{
+    shift->frame[(shift->digit_count - 1u) - digit] = code;
+}
+
+/**
+ *  @fn         displayShiftWrite4
+ *  @package    display_shift
+ *
+ *  @brief      Sets the segment codes of four consecutive digits.
+ *
+ *  @details    The frame holds the digits in reverse order, so the word is
+ *              byte-swapped (one REV) and stored with a single word write.
+ *              Needs a chain length multiple of 4 to keep the word aligned.
+ *              The latch copies whole frames, so the four digits switch
+ *              together.
+ *
+ *  @param      shift [in] : Driver instance.
+ *  @param      group [in] : Digits 4 * group .. 4 * group + 3.
+ *  @param      word  [in] : Packed codes, e.g. displayPackDecimal4(), the
+ *                           lowest byte on the lowest digit.
+ *
+ *  @return     DISPLAY_SHIFT_OK      : if the word was stored.
+ *              DISPLAY_SHIFT_INVALID : if the chain length is not a multiple
+ *                                      of 4 or `group` is past its end.
+ */
+static inline display_shift_status_t displayShiftWrite4(display_shift_t *shift, uint8_t group,
+                                                        uint32_t word)
+{
+    display_shift_status_t ret = DISPLAY_SHIFT_INVALID;
+
+    uint8_t words = (uint8_t)(shift->digit_count >> 2u);
+
+    if (((shift->digit_count & 3u) != 0u) || (group >= words))
+    {
+        goto end_of_function;
+    }
+
+    shift->frame_word[(words - 1u) - group] = __builtin_bswap32(word);
+
+    ret = DISPLAY_SHIFT_OK;
+
+end_of_function:
+    return ret;
+}
+
+/**
+ *  @fn         displayShiftInit
+ *  @package    display_shift
+ *
+ *  @brief      Configures the SPI, the latch pin, the timer and both streams.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Validates the chain length and the SPI baud field.
+ *                  - Derives PSC/ARR for `refresh_hz * digit_count` bytes per
+ *                    second, and the CH1 tick at which one byte has been
+ *                    shifted; that tick has to fit in the period.
+ *                  - Blanks the frame and builds the latch table.
+ *                  - Sets RCLK low as an output and the SPI as a TX master.
+ *                  - Loads an unreachable CCR1 with UG, then the real one in
+ *                    preload, so no latch beat runs before the first byte.
+ *                  - Starts both streams, enables their requests and the timer.
+ *
+ *  @param      shift  [out] : Driver instance to be initialised.
+ *  @param      config [in]  : Chain and hardware resources.
+ *
+ *  @return     DISPLAY_SHIFT_OK     : if the chain is being refreshed.
+ *              DISPLAY_SHIFT_INVALID: if the configuration can not be honoured.
+ */
+static inline display_shift_status_t displayShiftInit(display_shift_t *shift,
+                                                      const display_shift_config_t *config)
+{
+    display_shift_status_t ret = DISPLAY_SHIFT_INVALID;
+
+    uint32_t latch_bit   = 0u;
+    uint32_t ticks       = 0u;
+    uint32_t prescaler   = 0u;
+    uint32_t reload      = 0u;
+    uint32_t shift_ticks = 0u;
+    uint8_t  index       = 0u;
+
+    if ((config->digit_count < DISPLAY_SHIFT_MIN_DIGITS) ||
+        (config->digit_count > DISPLAY_SHIFT_MAX_DIGITS) ||
+        (config->spi_baud > DISPLAY_SHIFT_BAUD_MAX) ||
+        (config->latch_pin > 15u) ||
+        (config->refresh_hz == 0u) || (config->spi_clock_hz == 0u))
+    {
+        goto end_of_function;
+    }
+
+    /* Byte period and latch tick --------------------------------------------*/
+    ticks = (config->timer_clock_hz / (config->refresh_hz * config->digit_count));
+
+    if (ticks < 2u)
+    {
+        goto end_of_function;
+    }
+
+    prescaler = ((ticks - 1u) / DISPLAY_MUX_TIMER_MAX);
+
+    if (prescaler >= DISPLAY_MUX_TIMER_MAX)
+    {
+        goto end_of_function;
+    }
+
+    reload = ((ticks / (prescaler + 1u)) - 1u);
+
+    shift_ticks = (uint32_t)
+    (
+        (((uint64_t)(DISPLAY_SHIFT_BYTE_CLOCKS << config->spi_baud) * config->timer_clock_hz) /
+         config->spi_clock_hz) + DISPLAY_SHIFT_DMA_MARGIN
+    );
+
+    shift_ticks = ((shift_ticks + prescaler) / (prescaler + 1u));
+
+    if (shift_ticks > reload)
+    {
+        goto end_of_function;
+    }
+
+    /* Frame and latch table -------------------------------------------------*/
+    shift->timer       = config->timer;
+    shift->digit_count = config->digit_count;
+
+    latch_bit = GPIO_PIN(config->latch_pin);
+
+    for (index = 0u; index < DISPLAY_SHIFT_MAX_DIGITS; index++)
+    {
+        shift->frame[index] = DISPLAY_CODE_BLANK;
+        shift->latch[index] = (latch_bit << GPIO_BSRR_RESET_SHIFT);
+    }
+
+    shift->latch[config->digit_count - 1u] = latch_bit;
+
+    /* RCLK low, then output -------------------------------------------------*/
+    config->latch_port->BSRR = (latch_bit << GPIO_BSRR_RESET_SHIFT);
+
+    gpioRegisterUpdate(&config->latch_port->MODER,
+                       (GPIO_SPREAD2(latch_bit) * 3u),
+                       (GPIO_SPREAD2(latch_bit) * GPIO_MODE_OUTPUT));
+
+    /* SPI as a bare TX shifter, mode 0, MSB first ---------------------------*/
+    config->spi->CR1 = 0u;
+    config->spi->CR2 = 0u;
+    config->spi->CR1 =
+    (
+        SPI_CR1_MSTR |      /* Master */
+        SPI_CR1_SSM  |      /* No NSS pin */
+        SPI_CR1_SSI  |
+        ((uint32_t)config->spi_baud << SPI_CR1_BR_Pos)
+    );
+    config->spi->CR1 |= SPI_CR1_SPE;
+
+    /* Pacing timer, CH1 frozen with preload ---------------------------------*/
+    config->timer->CR1   = 0u;
+    config->timer->DIER  = 0u;
+    config->timer->PSC   = prescaler;
+    config->timer->ARR   = reload;
+    config->timer->CCMR1 = TIM_CCMR1_OC1PE;
+    config->timer->CCR1  = (reload + 1u);   /* No latch beat in the first period */
+    config->timer->EGR   = TIM_EGR_UG;
+    config->timer->CCR1  = shift_ticks;     /* Active from the first update on */
+    config->timer->SR    = 0u;
+
+    /* Streams: latch words, frame bytes -------------------------------------*/
+    displayDmaStreamStart(config->dma, config->latch_stream, config->latch_channel,
+                          &shift->latch[0], &config->latch_port->BSRR, config->digit_count, 1u);
+
+    displayDmaStreamProgram(config->dma, config->data_stream,
+                            (uintptr_t)&shift->frame[0], (uintptr_t)&config->spi->DR,
+                            config->digit_count,
+    (
+        (config->data_channel << DMA_SxCR_CHSEL_Pos) |
+        DMA_SxCR_PL_1    |      /* High priority, 8-bit beats */
+        DMA_SxCR_MINC    |      /* Walk the frame */
+        DMA_SxCR_CIRC    |      /* Restart at the far end of the chain */
+        DMA_SxCR_DIR_0          /* Memory to peripheral */
+    ));
+
+    /* One byte per update, one latch word per CH1 match ---------------------*/
+    config->timer->DIER  = (TIM_DIER_UDE | TIM_DIER_CC1DE);
+    config->timer->CR1   = (TIM_CR1_ARPE | TIM_CR1_CEN);
+
+    ret = DISPLAY_SHIFT_OK;
+
+end_of_function:
+    return ret;
+}
+
+#endif /* DISPLAY_SHIFT_H_ */
+/* end of file */
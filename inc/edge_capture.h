@@ -0,0 +1,443 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes edge_capture
+ *
+ *  @package    edge_capture
+ *  @brief      This module provides key edge timestamps latched by timer input
+ *              capture and moved to RAM by DMA, with a time-domain debounce
+ *              built on them.
+ *
+ *  @details    Each key sits on a timer channel set to capture both edges. The
+ *              capture latches the counter on the edge itself, and the channel
+ *              DMA request copies CCRx into a circular ring of the lane, so no
+ *              interrupt runs and GPIOx->IDR is never sampled while capturing.
+ *
+ *              - **Timestamps**: a stamp is exact to one timer tick whatever
+ *                the CPU is doing. Run unprescaled from an 84 MHz APB1 timer
+ *                clock, that is two core cycles. 32-bit timers (TIM2, TIM5)
+ *                wrap after 51 s, 16-bit ones after 65536 ticks; the width is
+ *                probed at init and every difference is taken modulo it.
+ *
+ *              - **Levels**: captures alternate between rising and falling
+ *                edges, so the level after each edge is the initial level
+ *                toggled once per stamp. The input filter (ICxF) drops glitches
+ *                shorter than a few microseconds as whole pulses, which keeps
+ *                the alternation. `raw` is the level mask built that way, a
+ *                drop-in sample for debounceUpdate().
+ *
+ *              - **Debounce**: a lane settles once no edge arrived for
+ *                `settle_ticks`. The press or release time kept is the stamp of
+ *                the first edge of the bounce burst, not the end of the wait,
+ *                and `held` is the exact duration of the previous state.
+ *
+ *              edgeCaptureUpdate() has to run at least once per counter wrap
+ *              and before a lane ring fills up (EDGE_CAPTURE_SLOTS edges).
+ *
+ *              The timer, DMA and GPIO clocks and the channel alternate
+ *              functions have to be set up by the caller before
+ *              edgeCaptureInit() runs.
+ *
+ *  @file       edge_capture.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef EDGE_CAPTURE_H_
+#define EDGE_CAPTURE_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stddef.h>
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+#include "display_dma.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def EDGE_CAPTURE_MAX_LANES
+ * @package    edge_capture
+ * @brief Capture channels of one timer.
+ */
+#define EDGE_CAPTURE_MAX_LANES      (uint8_t)(4U)
+
+/**
+ * @def EDGE_CAPTURE_SLOTS
+ * @package    edge_capture
+ * @brief Stamps in the DMA ring of a lane, a power of two.
+ */
+#define EDGE_CAPTURE_SLOTS          (uint32_t)(16U)
+
+/**
+ * @def EDGE_CAPTURE_FILTER_MAX
+ * @package    edge_capture
+ * @brief Largest ICxF input filter setting.
+ */
+#define EDGE_CAPTURE_FILTER_MAX     (uint8_t)(15U)
+
+/**
+ * @def EDGE_CAPTURE_CCER_BOTH
+ * @package    edge_capture
+ * @brief CCER bits of channel 1 capturing both edges: CC1E, CC1P, CC1NP.
+ */
+#define EDGE_CAPTURE_CCER_BOTH      (uint32_t)(0xBU)
+
+_Static_assert((EDGE_CAPTURE_SLOTS & (EDGE_CAPTURE_SLOTS - 1u)) == 0u,
+               "EDGE_CAPTURE_SLOTS must be a power of two");
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    edgeCaptureStatus
+ *  @typedef edge_capture_status_t
+ *  @package    edge_capture
+ *
+ *  @brief   Result of the capture configuration.
+ */
+typedef enum edgeCaptureStatus
+{
+    EDGE_CAPTURE_OK         = (uint8_t)(0u),    /**< Channels capturing */
+    EDGE_CAPTURE_INVALID    = (uint8_t)(1u)     /**< Rejected configuration */
+} edge_capture_status_t;
+
+/**
+ *  @struct  edgeCaptureChannel
+ *  @typedef edge_capture_channel_t
+ *  @package    edge_capture
+ *
+ *  @brief   Timer channel and DMA stream of one key.
+ */
+typedef struct edgeCaptureChannel
+{
+    DMA_Stream_TypeDef  *stream;        /**< Stream serving the channel request */
+    uint8_t              dma_channel;   /**< Request channel of that stream, 0..7 */
+    uint8_t              tim_channel;   /**< Timer channel, 1..4 */
+} edge_capture_channel_t;
+
+/**
+ *  @struct  edgeCaptureConfig
+ *  @typedef edge_capture_config_t
+ *  @package    edge_capture
+ *
+ *  @brief   Timer, DMA and keys of a capture instance.
+ */
+typedef struct edgeCaptureConfig
+{
+    TIM_TypeDef             *timer;                             /**< Capture timer */
+    DMA_TypeDef             *dma;                               /**< Controller of the streams */
+    uint32_t                 timer_clock_hz;                    /**< Timer kernel clock */
+    uint32_t                 tick_hz;                           /**< Stamp resolution, a divisor of it */
+    uint32_t                 settle_ticks;                      /**< Quiet time that ends a bounce burst */
+    uint16_t                 initial;                           /**< Lane levels before the first edge */
+    uint8_t                  filter;                            /**< ICxF, 0..EDGE_CAPTURE_FILTER_MAX */
+    uint8_t                  lane_count;                        /**< Keys, 1..EDGE_CAPTURE_MAX_LANES */
+    edge_capture_channel_t   lanes[EDGE_CAPTURE_MAX_LANES];     /**< Key n is bit n of the masks */
+} edge_capture_config_t;
+
+/**
+ *  @struct  edgeCaptureLane
+ *  @typedef edge_capture_lane_t
+ *  @package    edge_capture
+ *
+ *  @brief   Runtime state of one key.
+ */
+typedef struct edgeCaptureLane
+{
+    DMA_Stream_TypeDef  *stream;                        /**< Stream filling `stamps` */
+    uint32_t             last;                          /**< Stamp of the newest edge */
+    uint32_t             burst;                         /**< Stamp of the first edge of the burst */
+    uint32_t             settled_at;                    /**< Stamp of the settled press or release */
+    uint32_t             held;                          /**< Ticks spent in the previous settled state */
+    uint8_t              tail;                          /**< Next ring slot to be read */
+    uint8_t              quiet;                         /**< 1u once `settle_ticks` passed without edges */
+    volatile uint32_t    stamps[EDGE_CAPTURE_SLOTS];    /**< Circular DMA target */
+} edge_capture_lane_t;
+
+/**
+ *  @struct  edgeCapture
+ *  @typedef edge_capture_t
+ *  @package    edge_capture
+ *
+ *  @brief   Runtime state of a capture instance.
+ *
+ *  @details Only touched by the context calling edgeCaptureUpdate(); the DMA
+ *           only writes the rings.
+ */
+typedef struct edgeCapture
+{
+    TIM_TypeDef          *timer;                            /**< Capture timer */
+    uint32_t              counter_mask;                     /**< Counter width, 0xFFFF or 0xFFFFFFFF */
+    uint32_t              settle_ticks;                     /**< Quiet time that ends a bounce burst */
+    uint16_t              raw;                              /**< Level after the newest edge, per lane */
+    uint16_t              state;                            /**< Settled level, per lane */
+    uint8_t               lane_count;                       /**< Keys */
+    edge_capture_lane_t   lanes[EDGE_CAPTURE_MAX_LANES];    /**< Key n is bit n of the masks */
+} edge_capture_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         edgeCaptureNow
+ *  @package    edge_capture
+ *
+ *  @brief      Current counter value, in the time base of the stamps.
+ *
+ *  @param      capture [in] : Capture instance.
+ *
+ *  @return     The counter.
+ */
+static inline uint32_t edgeCaptureNow(const edge_capture_t *capture)
+{
+    return capture->timer->CNT;
+}
+
+/**
+ *  @fn         edgeCaptureTicks
+ *  @package    edge_capture
+ *
+ *  @brief      Ticks from `from` to `to`, modulo the counter width.
+ *
+ *  @param      capture [in] : Capture instance.
+ *  @param      from    [in] : Earlier stamp.
+ *  @param      to      [in] : Later stamp.
+ *
+ *  @return     The elapsed ticks.
+ */
+static inline uint32_t edgeCaptureTicks(const edge_capture_t *capture, uint32_t from, uint32_t to)
+{
+    return ((to - from) & capture->counter_mask);
+}
+
+/**
+ *  @fn         edgeCaptureDrain
+ *  @package    edge_capture
+ *
+ *  @brief      Consumes the stamps the DMA wrote into a lane ring.
+ *
+ *  @details    The ring head is derived from NDTR, which the circular stream
+ *              reloads to EDGE_CAPTURE_SLOTS. Every stamp toggles the lane bit
+ *              of `raw`; a stamp following a quiet lane opens a new burst.
+ *
+ *  @param      capture [inout] : Capture instance.
+ *  @param      lane    [in]    : Key index.
+ */
+static inline void edgeCaptureDrain(edge_capture_t *capture, uint8_t lane)
+{
+    edge_capture_lane_t *key = &capture->lanes[lane];
+
+    uint32_t head  = ((EDGE_CAPTURE_SLOTS - key->stream->NDTR) & (EDGE_CAPTURE_SLOTS - 1u));
+    uint32_t stamp = 0u;
+
+    while (key->tail != head)
+    {
+        stamp = key->stamps[key->tail];
+
+        if ((key->quiet != 0u) || (edgeCaptureTicks(capture, key->last, stamp) >= capture->settle_ticks))
+        {
+            key->burst = stamp;
+        }
+
+        key->last  = stamp;
+        key->quiet = 0u;
+        key->tail  = (uint8_t)((key->tail + 1u) & (EDGE_CAPTURE_SLOTS - 1u));
+
+        capture->raw ^= (uint16_t)(1u << lane);
+    }
+}
+
+/**
+ *  @fn         edgeCaptureUpdate
+ *  @package    edge_capture
+ *
+ *  @brief      Drains every lane and settles the quiet ones.
+ *
+ *  @details    A lane whose newest edge is `settle_ticks` old takes its raw
+ *              level as settled state. When that changes the state, the burst
+ *              start becomes `settled_at` and the time since the previous one
+ *              becomes `held`.
+ *
+ *  @param      capture [inout] : Capture instance.
+ *
+ *  @return     Lanes whose settled state changed, one bit per key.
+ */
+static inline uint16_t edgeCaptureUpdate(edge_capture_t *capture)
+{
+    uint16_t changed = 0u;
+    uint32_t now     = 0u;
+    uint8_t  lane    = 0u;
+
+    for (lane = 0u; lane < capture->lane_count; lane++)
+    {
+        edgeCaptureDrain(capture, lane);
+    }
+
+    now = edgeCaptureNow(capture);
+
+    for (lane = 0u; lane < capture->lane_count; lane++)
+    {
+        edge_capture_lane_t *key = &capture->lanes[lane];
+
+        uint16_t bit = (uint16_t)(1u << lane);
+
+        if ((key->quiet != 0u) || (edgeCaptureTicks(capture, key->last, now) < capture->settle_ticks))
+        {
+            continue;
+        }
+
+        key->quiet = 1u;
+
+        if (((capture->raw ^ capture->state) & bit) != 0u)
+        {
+            key->held       = edgeCaptureTicks(capture, key->settled_at, key->burst);
+            key->settled_at = key->burst;
+
+            capture->state ^= bit;
+            changed        |= bit;
+        }
+    }
+
+    return changed;
+}
+
+/**
+ *  @fn         edgeCaptureInit
+ *  @package    edge_capture
+ *
+ *  @brief      Configures the timer channels and their DMA streams.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Validates the lanes, the filter and the tick rate, which
+ *                    has to fit the 16-bit prescaler.
+ *                  - Sets PSC for `tick_hz`, and probes the counter width by
+ *                    writing an all-ones ARR and reading it back.
+ *                  - Sets each channel as TIx input with the ICxF filter,
+ *                    capturing both edges, with its DMA request enabled.
+ *                  - Starts each stream, CCRx into the lane ring, 32-bit beats,
+ *                    circular, then the counter.
+ *
+ *  @param      capture [out] : Capture instance.
+ *  @param      config  [in]  : Timer, DMA and keys.
+ *
+ *  @return     EDGE_CAPTURE_OK     : if the channels are capturing.
+ *              EDGE_CAPTURE_INVALID: if the configuration was rejected.
+ */
+static inline edge_capture_status_t edgeCaptureInit(edge_capture_t *capture,
+                                                    const edge_capture_config_t *config)
+{
+    edge_capture_status_t ret = EDGE_CAPTURE_INVALID;
+
+    TIM_TypeDef *timer = config->timer;
+
+    uint32_t ccmr[2]   = { 0u, 0u };
+    uint32_t ccer      = 0u;
+    uint32_t dier      = 0u;
+    uint8_t  lane      = 0u;
+    uint8_t  slot      = 0u;
+
+    if ((config->lane_count == 0u) || (config->lane_count > EDGE_CAPTURE_MAX_LANES) ||
+        (config->filter > EDGE_CAPTURE_FILTER_MAX) || (config->tick_hz == 0u) ||
+        (config->tick_hz > config->timer_clock_hz) ||
+        ((config->timer_clock_hz / config->tick_hz) > 0x10000UL))
+    {
+        goto end_of_function;
+    }
+
+    for (lane = 0u; lane < config->lane_count; lane++)
+    {
+        uint8_t channel = config->lanes[lane].tim_channel;
+
+        if ((channel == 0u) || (channel > 4u) || (config->lanes[lane].stream == NULL) ||
+            (config->lanes[lane].dma_channel > 7u))
+        {
+            goto end_of_function;
+        }
+    }
+
+    /* Time base: free-running, full width ------------------------------------*/
+    timer->CR1  = 0u;
+    timer->DIER = 0u;
+    timer->CCER = 0u;
+    timer->PSC  = ((config->timer_clock_hz / config->tick_hz) - 1u);
+    timer->ARR  = 0xFFFFFFFFUL;
+
+    capture->timer        = timer;
+    capture->counter_mask = timer->ARR;
+    capture->settle_ticks = config->settle_ticks;
+    capture->raw          = (uint16_t)(config->initial & ((1u << config->lane_count) - 1u));
+    capture->state        = capture->raw;
+    capture->lane_count   = config->lane_count;
+
+    /* Channels: TIx input, filtered, both edges, DMA on capture -------------*/
+    for (lane = 0u; lane < config->lane_count; lane++)
+    {
+        uint8_t channel = (uint8_t)(config->lanes[lane].tim_channel - 1u);
+
+        ccmr[channel >> 1u] |= (((uint32_t)config->filter << 4u) | 1u) << (8u * (channel & 1u));
+        ccer                |= (EDGE_CAPTURE_CCER_BOTH << (4u * channel));
+        dier                |= (TIM_DIER_CC1DE << channel);
+    }
+
+    timer->CCMR1 = ccmr[0];
+    timer->CCMR2 = ccmr[1];
+    timer->EGR   = TIM_EGR_UG;
+
+    /* Streams: CCRx into the lane ring --------------------------------------*/
+    for (lane = 0u; lane < config->lane_count; lane++)
+    {
+        edge_capture_lane_t *key = &capture->lanes[lane];
+
+        uint8_t channel = (uint8_t)(config->lanes[lane].tim_channel - 1u);
+
+        key->stream     = config->lanes[lane].stream;
+        key->last       = 0u;
+        key->burst      = 0u;
+        key->settled_at = 0u;
+        key->held       = 0u;
+        key->tail       = 0u;
+        key->quiet      = 1u;
+
+        for (slot = 0u; slot < EDGE_CAPTURE_SLOTS; slot++)
+        {
+            key->stamps[slot] = 0u;
+        }
+
+        displayDmaStreamProgram(config->dma, key->stream,
+                                (uintptr_t)&key->stamps[0], (uintptr_t)(&timer->CCR1 + channel),
+                                EDGE_CAPTURE_SLOTS,
+        (
+            ((uint32_t)config->lanes[lane].dma_channel << DMA_SxCR_CHSEL_Pos) |
+            DMA_SxCR_PL_1    |      /* High priority */
+            DMA_SxCR_MSIZE_1 |      /* 32-bit memory beats */
+            DMA_SxCR_PSIZE_1 |      /* 32-bit peripheral beats */
+            DMA_SxCR_MINC    |      /* Walk the ring */
+            DMA_SxCR_CIRC           /* Peripheral to memory, restart at slot 0 */
+        ));
+    }
+
+    timer->SR   = 0u;
+    timer->DIER = dier;
+    timer->CCER = ccer;
+    timer->CR1  = TIM_CR1_CEN;
+
+    ret = EDGE_CAPTURE_OK;
+
+end_of_function:
+    return ret;
+}
+
+#endif /* EDGE_CAPTURE_H_ */
+/* end of file */
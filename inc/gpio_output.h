@@ -0,0 +1,133 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes gpio_output
+ *
+ *  @package    gpio_output
+ *  @brief      This module provides an atomic GPIO output path built on the
+ *              bit set/reset register (BSRR) of the STM32F4 GPIO ports.
+ *
+ *  @details    Writing ODR replaces the state of every pin of a port, and
+ *              updating it with a read-modify-write races against any interrupt
+ *              touching the same port. BSRR sets the pins written in its low
+ *              half and resets the pins written in its high half in a single
+ *              bus write, leaving every other pin untouched.
+ *
+ *              - **Precomputed words**: `GPIO_BSRR_WORD` folds a pin mask and a
+ *                wanted level into the BSRR word at compile time, so an output
+ *                table can hold ready-to-store words instead of raw levels.
+ *
+ *              - **Runtime conversion**: `gpioBsrrFromTable` builds the same
+ *                words once from an existing level table when it is not known
+ *                at compile time.
+ *
+ *              - **Update**: `gpioBsrrWrite` is one store, with no read of the
+ *                port, so it needs no locking against other drivers of the port.
+ *
+ *  @file       gpio_output.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef GPIO_OUTPUT_H_
+#define GPIO_OUTPUT_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def GPIO_BSRR_RESET_SHIFT
+ * @package    gpio_output
+ * @brief Position of the reset half of the BSRR register.
+ */
+#define GPIO_BSRR_RESET_SHIFT       (uint32_t)(16U)
+
+/**
+ * @def GPIO_BSRR_PINS_MASK
+ * @package    gpio_output
+ * @brief Mask of the 16 pins of a GPIO port.
+ */
+#define GPIO_BSRR_PINS_MASK         (uint32_t)(0xFFFFU)
+
+/*==========================================
+ *             Private Macros
+ * ========================================== */
+
+/**
+ * @def GPIO_BSRR_WORD
+ * @package    gpio_output
+ * @brief Builds the BSRR word that drives the pins of `mask` to `value`.
+ *
+ * @details Pins of `mask` that are '1' in `value` go to the set half, the
+ *          remaining pins of `mask` go to the reset half. Pins outside `mask`
+ *          are left untouched by the store. Usable in constant initializers.
+ *
+ * @param mask  Pins owned by the caller, one bit per pin.
+ * @param value Wanted level of those pins.
+ *
+ * @return The 32-bit BSRR word.
+ */
+#define GPIO_BSRR_WORD(mask, value)                                                         \
+    (uint32_t)(                                                                             \
+        ((uint32_t)(value) & (uint32_t)(mask) & GPIO_BSRR_PINS_MASK) |                      \
+        (((~(uint32_t)(value)) & (uint32_t)(mask) & GPIO_BSRR_PINS_MASK)                    \
+            << GPIO_BSRR_RESET_SHIFT)                                                       \
+    )
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         gpioBsrrFromTable
+ *  @package    gpio_output
+ *
+ *  @brief      Converts a table of output levels into BSRR words.
+ *
+ *  @details    Meant to run once at init; the resulting words are then stored
+ *              with gpioBsrrWrite() on every update.
+ *
+ *  @param      levels     [in]  : Output levels, one entry per state.
+ *  @param      bsrr_words [out] : Destination of the BSRR words.
+ *  @param      count      [in]  : Number of entries of both tables.
+ *  @param      mask       [in]  : Pins driven by the table.
+ */
+static inline void gpioBsrrFromTable(const uint8_t *levels, uint32_t *bsrr_words,
+                                     uint32_t count, uint32_t mask)
+{
+    uint32_t index = 0u;
+
+    for (index = 0u; index < count; index++)
+    {
+        bsrr_words[index] = GPIO_BSRR_WORD(mask, levels[index]);
+    }
+}
+
+/**
+ *  @fn         gpioBsrrWrite
+ *  @package    gpio_output
+ *
+ *  @brief      Applies a precomputed BSRR word to a port in one store.
+ *
+ *  @param      port      [in] : GPIO port to be driven.
+ *  @param      bsrr_word [in] : Word built by GPIO_BSRR_WORD or gpioBsrrFromTable.
+ */
+static inline void gpioBsrrWrite(GPIO_TypeDef *port, uint32_t bsrr_word)
+{
+    port->BSRR = bsrr_word;
+}
+
+#endif /* GPIO_OUTPUT_H_ */
+/* end of file */
@@ -0,0 +1,223 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes gpio_pin
+ *
+ *  @package    gpio_pin
+ *  @brief      This module provides compile-time GPIO pin descriptors that fold
+ *              the mode, pull, output type, speed and alternate function of a
+ *              group of pins into ready-to-apply register values.
+ *
+ *  @details    A pin group is a set of pins of one port sharing the same setup,
+ *              e.g. "PB0..PB2, input, pull-down". `GPIO_PORT_GROUP` spreads the
+ *              16-bit pin mask onto the 2-bit (MODER, PUPDR, OSPEEDR) and 4-bit
+ *              (AFR) register fields with a few shifts and masks, so the whole
+ *              descriptor is a constant expression and can live in flash.
+ *
+ *              - **Masked writes**: gpioPortApply() updates every register the
+ *                group touches with a single read, clear-and-set, write. Fields
+ *                of the other pins are preserved, and registers the group does
+ *                not use (e.g. OSPEEDR for inputs) are not accessed at all.
+ *
+ *              - **Glitch-free order**: AFR, OTYPER, OSPEEDR and PUPDR are
+ *                written before MODER, so a pin switches mode with its final
+ *                type, pull and function already in place.
+ *
+ *              - **Cost**: with a `static const` descriptor the compiler sees
+ *                every mask as a constant; applying a group is at most six
+ *                load/BIC/ORR/store sequences and no per-pin loop.
+ *
+ *              Pins of one port with different setups are described by one
+ *              group each and applied in sequence. The port clock has to be
+ *              enabled by the caller before gpioPortApply() runs.
+ *
+ *  @file       gpio_pin.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef GPIO_PIN_H_
+#define GPIO_PIN_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/* MODER values */
+#define GPIO_MODE_INPUT             (uint32_t)(0U)
+#define GPIO_MODE_OUTPUT            (uint32_t)(1U)
+#define GPIO_MODE_AF                (uint32_t)(2U)
+#define GPIO_MODE_ANALOG            (uint32_t)(3U)
+
+/* PUPDR values */
+#define GPIO_PULL_NONE              (uint32_t)(0U)
+#define GPIO_PULL_UP                (uint32_t)(1U)
+#define GPIO_PULL_DOWN              (uint32_t)(2U)
+
+/* OTYPER values */
+#define GPIO_OTYPE_PUSH_PULL        (uint32_t)(0U)
+#define GPIO_OTYPE_OPEN_DRAIN       (uint32_t)(1U)
+
+/* OSPEEDR values */
+#define GPIO_SPEED_LOW              (uint32_t)(0U)
+#define GPIO_SPEED_MEDIUM           (uint32_t)(1U)
+#define GPIO_SPEED_HIGH             (uint32_t)(2U)
+#define GPIO_SPEED_VERY_HIGH        (uint32_t)(3U)
+
+/**
+ * @def GPIO_PIN
+ * @package    gpio_pin
+ * @brief Pin mask of a single pin number.
+ */
+#define GPIO_PIN(n)                 (uint32_t)(1UL << (n))
+
+/*==========================================
+ *             Private Macros
+ * ========================================== */
+
+/* Morton spread steps of a 16-bit mask, bit n ends up at bit 2n */
+#define GPIO_SPREAD2_STEP1(x)       ((((uint32_t)(x) & 0xFFFFUL) | (((uint32_t)(x) & 0xFFFFUL) << 8u)) & 0x00FF00FFUL)
+#define GPIO_SPREAD2_STEP2(x)       ((GPIO_SPREAD2_STEP1(x) | (GPIO_SPREAD2_STEP1(x) << 4u)) & 0x0F0F0F0FUL)
+#define GPIO_SPREAD2_STEP3(x)       ((GPIO_SPREAD2_STEP2(x) | (GPIO_SPREAD2_STEP2(x) << 2u)) & 0x33333333UL)
+
+/* Same for an 8-bit mask, bit n ends up at bit 4n */
+#define GPIO_SPREAD4_STEP1(x)       ((((uint32_t)(x) & 0xFFUL) | (((uint32_t)(x) & 0xFFUL) << 12u)) & 0x000F000FUL)
+#define GPIO_SPREAD4_STEP2(x)       ((GPIO_SPREAD4_STEP1(x) | (GPIO_SPREAD4_STEP1(x) << 6u)) & 0x03030303UL)
+
+/**
+ * @def GPIO_SPREAD2
+ * @package    gpio_pin
+ * @brief Moves bit n of a 16-bit pin mask to bit 2n, the LSB of its 2-bit field.
+ */
+#define GPIO_SPREAD2(pins)          (uint32_t)((GPIO_SPREAD2_STEP3(pins) | (GPIO_SPREAD2_STEP3(pins) << 1u)) & 0x55555555UL)
+
+/**
+ * @def GPIO_SPREAD4
+ * @package    gpio_pin
+ * @brief Moves bit n of an 8-bit pin mask to bit 4n, the LSB of its AFR field.
+ */
+#define GPIO_SPREAD4(pins)          (uint32_t)((GPIO_SPREAD4_STEP2(pins) | (GPIO_SPREAD4_STEP2(pins) << 3u)) & 0x11111111UL)
+
+/* 1 when the pin drives its output stage, i.e. output or alternate function */
+#define GPIO_PIN_DRIVES(mode)       (((mode) == GPIO_MODE_OUTPUT) || ((mode) == GPIO_MODE_AF))
+
+/**
+ * @def GPIO_PORT_GROUP
+ * @package    gpio_pin
+ * @brief Builds the `gpio_port_config_t` of a group of pins sharing one setup.
+ *
+ * @details Output type and speed are only touched for output and AF pins, the
+ *          alternate function only for AF pins. Usable in constant initializers.
+ *
+ * @param pins  Pins of the group, one bit per pin, e.g. GPIO_PIN(0) | GPIO_PIN(1).
+ * @param mode  GPIO_MODE_x.
+ * @param pull  GPIO_PULL_x.
+ * @param otype GPIO_OTYPE_x, ignored for input and analog pins.
+ * @param speed GPIO_SPEED_x, ignored for input and analog pins.
+ * @param af    Alternate function number 0..15, ignored unless mode is AF.
+ */
+#define GPIO_PORT_GROUP(pins, mode, pull, otype, speed, af)                                 \
+    {                                                                                       \
+        .moder_mask   = (GPIO_SPREAD2(pins) * 3u),                                          \
+        .moder        = (GPIO_SPREAD2(pins) * (mode)),                                      \
+        .pupdr_mask   = (GPIO_SPREAD2(pins) * 3u),                                          \
+        .pupdr        = (GPIO_SPREAD2(pins) * (pull)),                                      \
+        .ospeedr_mask = (GPIO_PIN_DRIVES(mode) ? (GPIO_SPREAD2(pins) * 3u) : 0u),           \
+        .ospeedr      = (GPIO_PIN_DRIVES(mode) ? (GPIO_SPREAD2(pins) * (speed)) : 0u),      \
+        .afr_mask     =                                                                     \
+        {                                                                                   \
+            (((mode) == GPIO_MODE_AF) ? (GPIO_SPREAD4((pins) & 0xFFu) * 0xFu) : 0u),        \
+            (((mode) == GPIO_MODE_AF) ? (GPIO_SPREAD4((pins) >> 8u) * 0xFu) : 0u)           \
+        },                                                                                  \
+        .afr          =                                                                     \
+        {                                                                                   \
+            (((mode) == GPIO_MODE_AF) ? (GPIO_SPREAD4((pins) & 0xFFu) * (af)) : 0u),        \
+            (((mode) == GPIO_MODE_AF) ? (GPIO_SPREAD4((pins) >> 8u) * (af)) : 0u)           \
+        },                                                                                  \
+        .otyper_mask  = (uint16_t)(GPIO_PIN_DRIVES(mode) ? (pins) : 0u),                    \
+        .otyper       = (uint16_t)(GPIO_PIN_DRIVES(mode) ? ((pins) * (otype)) : 0u)         \
+    }
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @struct  gpioPortConfig
+ *  @typedef gpio_port_config_t
+ *  @package    gpio_pin
+ *
+ *  @brief   Register fields owned by a pin group, and their wanted values.
+ *
+ *  @details A register whose mask is zero is left untouched.
+ */
+typedef struct gpioPortConfig
+{
+    uint32_t moder_mask;    /**< MODER fields of the group */
+    uint32_t moder;         /**< MODER values */
+    uint32_t pupdr_mask;    /**< PUPDR fields of the group */
+    uint32_t pupdr;         /**< PUPDR values */
+    uint32_t ospeedr_mask;  /**< OSPEEDR fields of the group */
+    uint32_t ospeedr;       /**< OSPEEDR values */
+    uint32_t afr_mask[2];   /**< AFRL/AFRH fields of the group */
+    uint32_t afr[2];        /**< AFRL/AFRH values */
+    uint16_t otyper_mask;   /**< OTYPER bits of the group */
+    uint16_t otyper;        /**< OTYPER values */
+} gpio_port_config_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         gpioRegisterUpdate
+ *  @package    gpio_pin
+ *
+ *  @brief      Replaces the fields of `mask` in a register with one write.
+ *
+ *  @param      reg   [in] : Register to be updated.
+ *  @param      mask  [in] : Fields owned by the caller.
+ *  @param      value [in] : Wanted value of those fields.
+ */
+static inline void gpioRegisterUpdate(volatile uint32_t *reg, uint32_t mask, uint32_t value)
+{
+    if (mask != 0u)
+    {
+        *reg = ((*reg & ~mask) | value);
+    }
+}
+
+/**
+ *  @fn         gpioPortApply
+ *  @package    gpio_pin
+ *
+ *  @brief      Applies a pin group to a port.
+ *
+ *  @details    Every register is written at most once, with MODER last.
+ *
+ *  @param      port   [in] : GPIO port of the group.
+ *  @param      config [in] : Group built with GPIO_PORT_GROUP.
+ */
+static inline void gpioPortApply(GPIO_TypeDef *port, const gpio_port_config_t *config)
+{
+    gpioRegisterUpdate(&port->AFR[0],  config->afr_mask[0],  config->afr[0]);
+    gpioRegisterUpdate(&port->AFR[1],  config->afr_mask[1],  config->afr[1]);
+    gpioRegisterUpdate(&port->OTYPER,  config->otyper_mask,  config->otyper);
+    gpioRegisterUpdate(&port->OSPEEDR, config->ospeedr_mask, config->ospeedr);
+    gpioRegisterUpdate(&port->PUPDR,   config->pupdr_mask,   config->pupdr);
+    gpioRegisterUpdate(&port->MODER,   config->moder_mask,   config->moder);
+}
+
+#endif /* GPIO_PIN_H_ */
+/* end of file */
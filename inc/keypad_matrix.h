@@ -0,0 +1,488 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes keypad_matrix
+ *
+ *  @package    keypad_matrix
+ *  @brief      This module provides an interrupt-assisted row/column keypad
+ *              matrix scanner, from 1x1 up to 8x8 keys, producing one packed
+ *              key bitmap per scan.
+ *
+ *  @details    Rows and columns each sit on consecutive pins of a port. Rows
+ *              are open-drain outputs, one pulled low at a time; columns are
+ *              inputs with pull-ups, so a pressed key reads low on its column
+ *              while its row is selected.
+ *
+ *              - **Scan**: a timer update interrupt reads the columns of the
+ *                selected row with one IDR load, then selects the next row with
+ *                one BSRR store. The whole period is left to the lines to
+ *                settle. A frame costs exactly `row_count` port reads, whatever
+ *                the number of keys or how many are pressed.
+ *
+ *              - **Bitmap**: row r lands on bits [r * col_count, (r + 1) *
+ *                col_count) of a 64-bit word, '1' meaning pressed. A matrix of
+ *                up to 16 keys fits the low 16 bits, which feed debounceUpdate()
+ *                and parity32() as they are.
+ *
+ *              - **Idle**: after `idle_frames` frames with no key down, every
+ *                row is pulled low, the timer stops and the columns wake the
+ *                scan through EXTI on a falling edge. Nothing runs while the
+ *                keypad is untouched, so the core can sleep.
+ *
+ *              The application defines the timer and EXTI vectors and calls
+ *              keypadMatrixTimerIrqHandler() and keypadMatrixExtiIrqHandler()
+ *              from them. Both share one NVIC priority, so they never preempt
+ *              each other. The column EXTI lines can not be shared with other
+ *              ports. The timer and GPIO clocks have to be enabled by the
+ *              caller before keypadMatrixInit() runs.
+ *
+ *  @file       keypad_matrix.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef KEYPAD_MATRIX_H_
+#define KEYPAD_MATRIX_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+#include <stddef.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+#include "gpio_output.h"
+#include "gpio_pin.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def KEYPAD_MATRIX_MAX_LINES
+ * @package    keypad_matrix
+ * @brief Maximum number of rows, and of columns, of one matrix.
+ */
+#define KEYPAD_MATRIX_MAX_LINES     (uint8_t)(8U)
+
+/**
+ * @def KEYPAD_MATRIX_TIMER_MAX
+ * @package    keypad_matrix
+ * @brief Largest value of a 16-bit timer prescaler or auto-reload register.
+ */
+#define KEYPAD_MATRIX_TIMER_MAX     (uint32_t)(0x10000UL)
+
+/**
+ * @def KEYPAD_MATRIX_PORT_STRIDE
+ * @package    keypad_matrix
+ * @brief Address distance between two GPIO ports, the EXTICR port index step.
+ */
+#define KEYPAD_MATRIX_PORT_STRIDE   (uint32_t)(0x400U)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    keypadMatrixStatus
+ *  @typedef keypad_matrix_status_t
+ *  @package    keypad_matrix
+ *
+ *  @brief   Result of the scanner configuration.
+ */
+typedef enum keypadMatrixStatus
+{
+    KEYPAD_MATRIX_OK        = (uint8_t)(0u),    /**< Scanner idle, waiting for a key */
+    KEYPAD_MATRIX_INVALID   = (uint8_t)(1u)     /**< Rejected configuration */
+} keypad_matrix_status_t;
+
+/**
+ *  @typedef keypad_matrix_frame_fn
+ *  @package    keypad_matrix
+ *
+ *  @brief   Called from the timer interrupt with the bitmap of every frame.
+ */
+typedef void (*keypad_matrix_frame_fn)(void *context, uint64_t keys);
+
+/**
+ *  @struct  keypadMatrixConfig
+ *  @typedef keypad_matrix_config_t
+ *  @package    keypad_matrix
+ *
+ *  @brief   Wiring and timing of a keypad matrix.
+ */
+typedef struct keypadMatrixConfig
+{
+    TIM_TypeDef            *timer;              /**< Row scan timer */
+    IRQn_Type               timer_irq;          /**< Update interrupt of that timer */
+    uint32_t                priority;           /**< NVIC priority of the scan and the wake-up */
+    uint32_t                timer_clock_hz;     /**< Timer kernel clock */
+    uint32_t                scan_hz;            /**< Full frames per second */
+    GPIO_TypeDef           *row_port;           /**< Port of the row lines */
+    uint8_t                 row_shift;          /**< Pin of row 0 */
+    uint8_t                 row_count;          /**< Rows, 1..KEYPAD_MATRIX_MAX_LINES */
+    GPIO_TypeDef           *col_port;           /**< Port of the column lines */
+    uint8_t                 col_shift;          /**< Pin of column 0, also its EXTI line */
+    uint8_t                 col_count;          /**< Columns, 1..KEYPAD_MATRIX_MAX_LINES */
+    uint8_t                 idle_frames;        /**< Empty frames before idling, 0 never idles */
+    keypad_matrix_frame_fn  on_frame;           /**< Frame callback, may be NULL */
+    void                   *context;            /**< Argument of `on_frame` */
+} keypad_matrix_config_t;
+
+/**
+ *  @struct  keypadMatrix
+ *  @typedef keypad_matrix_t
+ *  @package    keypad_matrix
+ *
+ *  @brief   Runtime state of a keypad matrix scanner.
+ *
+ *  @details `state` and `frames` are the outputs, everything else belongs to
+ *           the interrupt handlers.
+ */
+typedef struct keypadMatrix
+{
+    TIM_TypeDef            *timer;                              /**< Row scan timer */
+    GPIO_TypeDef           *row_port;                           /**< Port of the rows */
+    GPIO_TypeDef           *col_port;                           /**< Port of the columns */
+    uint32_t                row_word[KEYPAD_MATRIX_MAX_LINES];  /**< BSRR word selecting each row */
+    uint32_t                idle_word;                          /**< BSRR word pulling every row low */
+    uint32_t                col_lines;                          /**< Column pins, and EXTI lines */
+    uint8_t                 col_shift;                          /**< Pin of column 0 */
+    uint8_t                 col_count;                          /**< Columns */
+    uint8_t                 row_count;                          /**< Rows */
+    uint8_t                 idle_frames;                        /**< Empty frames before idling */
+    keypad_matrix_frame_fn  on_frame;                           /**< Frame callback */
+    void                   *context;                            /**< Argument of `on_frame` */
+    volatile uint8_t        row;                                /**< Row read by the next update */
+    volatile uint8_t        quiet;                              /**< Empty frames in a row */
+    volatile uint8_t        scanning;                           /**< 1u while the timer runs */
+    uint64_t                scan;                               /**< Bitmap of the frame in progress */
+    volatile uint64_t       state;                              /**< Bitmap of the last full frame */
+    volatile uint32_t       frames;                             /**< Full frames scanned */
+} keypad_matrix_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         keypadMatrixColumns
+ *  @package    keypad_matrix
+ *
+ *  @brief      Reads the pressed columns of the selected rows.
+ *
+ *  @param      keypad [in] : Driver instance.
+ *
+ *  @return     One bit per column, '1' when its line is pulled low.
+ */
+static inline uint32_t keypadMatrixColumns(const keypad_matrix_t *keypad)
+{
+    return ((~keypad->col_port->IDR & keypad->col_lines) >> keypad->col_shift);
+}
+
+/**
+ *  @fn         keypadMatrixExtiIrq
+ *  @package    keypad_matrix
+ *
+ *  @brief      NVIC line serving one EXTI line.
+ *
+ *  @param      line [in] : EXTI line, 0..15.
+ *
+ *  @return     EXTI0_IRQn..EXTI4_IRQn, EXTI9_5_IRQn or EXTI15_10_IRQn.
+ */
+static inline IRQn_Type keypadMatrixExtiIrq(uint8_t line)
+{
+    IRQn_Type ret = EXTI15_10_IRQn;
+
+    if (line < 5u)
+    {
+        ret = (IRQn_Type)((uint32_t)EXTI0_IRQn + line);
+    }
+    else if (line < 10u)
+    {
+        ret = EXTI9_5_IRQn;
+    }
+
+    return ret;
+}
+
+/**
+ *  @fn         keypadMatrixStartScan
+ *  @package    keypad_matrix
+ *
+ *  @brief      Leaves idle: masks the column wake-up and scans from row 0.
+ *
+ *  @param      keypad [in] : Driver instance.
+ */
+static inline void keypadMatrixStartScan(keypad_matrix_t *keypad)
+{
+    EXTI->IMR &= ~keypad->col_lines;
+    EXTI->PR   = keypad->col_lines;
+
+    keypad->row      = 0u;
+    keypad->quiet    = 0u;
+    keypad->scan     = 0u;
+    keypad->scanning = 1u;
+
+    keypad->row_port->BSRR = keypad->row_word[0];
+
+    keypad->timer->CNT  = 0u;
+    keypad->timer->SR   = ~TIM_SR_UIF;
+    keypad->timer->CR1 |= TIM_CR1_CEN;
+}
+
+/**
+ *  @fn         keypadMatrixEnterIdle
+ *  @package    keypad_matrix
+ *
+ *  @brief      Stops the scan and arms the column wake-up.
+ *
+ *  @details    With every row low, any key pulls its column low. A key already
+ *              down when the lines are unmasked gives no edge, so the columns
+ *              are read once more and the scan restarts straight away.
+ *
+ *  @param      keypad [in] : Driver instance.
+ */
+static inline void keypadMatrixEnterIdle(keypad_matrix_t *keypad)
+{
+    keypad->timer->CR1 &= ~TIM_CR1_CEN;
+    keypad->scanning    = 0u;
+
+    keypad->row_port->BSRR = keypad->idle_word;
+
+    EXTI->PR   = keypad->col_lines;
+    EXTI->IMR |= keypad->col_lines;
+
+    if (keypadMatrixColumns(keypad) != 0u)
+    {
+        keypadMatrixStartScan(keypad);
+    }
+}
+
+/**
+ *  @fn         keypadMatrixExtiIrqHandler
+ *  @package    keypad_matrix
+ *
+ *  @brief      Wakes the scan on a column edge; call it from the EXTI vectors
+ *              of the column lines.
+ *
+ *  @param      keypad [in] : Driver instance.
+ */
+static inline void keypadMatrixExtiIrqHandler(keypad_matrix_t *keypad)
+{
+    if ((EXTI->PR & keypad->col_lines) != 0u)
+    {
+        keypadMatrixStartScan(keypad);
+    }
+}
+
+/**
+ *  @fn         keypadMatrixTimerIrqHandler
+ *  @package    keypad_matrix
+ *
+ *  @brief      Reads one row and selects the next; call it from the scan timer
+ *              vector.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Acknowledges the update flag.
+ *                  - Folds the columns of the current row into the frame.
+ *                  - After the last row, publishes the frame to `state`, calls
+ *                    `on_frame` and either idles or restarts at row 0.
+ *                  - Selects the next row with one BSRR store.
+ *
+ *  @param      keypad [in] : Driver instance.
+ */
+static inline void keypadMatrixTimerIrqHandler(keypad_matrix_t *keypad)
+{
+    uint8_t row = keypad->row;
+
+    keypad->timer->SR = ~TIM_SR_UIF;
+
+    keypad->scan |= ((uint64_t)keypadMatrixColumns(keypad) << (row * keypad->col_count));
+
+    row++;
+
+    if (row >= keypad->row_count)
+    {
+        keypad->state = keypad->scan;
+        keypad->frames++;
+
+        if (keypad->on_frame != NULL)
+        {
+            keypad->on_frame(keypad->context, keypad->scan);
+        }
+
+        keypad->quiet = (keypad->scan != 0u) ? 0u : (uint8_t)(keypad->quiet + 1u);
+        keypad->scan  = 0u;
+        row           = 0u;
+
+        if ((keypad->idle_frames != 0u) && (keypad->quiet >= keypad->idle_frames))
+        {
+            keypadMatrixEnterIdle(keypad);
+            goto end_of_function;
+        }
+    }
+
+    keypad->row = row;
+
+    keypad->row_port->BSRR = keypad->row_word[row];
+
+end_of_function:
+    return;
+}
+
+/**
+ *  @fn         keypadMatrixInit
+ *  @package    keypad_matrix
+ *
+ *  @brief      Configures the lines, the scan timer and the column wake-up.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Validates the line counts and pin ranges.
+ *                  - Precomputes the BSRR word of every row and the idle word.
+ *                  - Sets the rows as open-drain outputs, the columns as
+ *                    pulled-up inputs.
+ *                  - Derives PSC/ARR for `scan_hz * row_count` updates per
+ *                    second and enables the update interrupt, timer stopped.
+ *                  - Routes the column lines to EXTI on falling edges and
+ *                    enables their NVIC lines.
+ *                  - Enters idle, or starts scanning at once if a key is down
+ *                    or `idle_frames` is 0.
+ *
+ *  @param      keypad [out] : Driver instance to be initialised.
+ *  @param      config [in]  : Wiring and timing.
+ *
+ *  @return     KEYPAD_MATRIX_OK     : if the scanner is armed.
+ *              KEYPAD_MATRIX_INVALID: if the configuration can not be honoured.
+ */
+static inline keypad_matrix_status_t keypadMatrixInit(keypad_matrix_t *keypad,
+                                                      const keypad_matrix_config_t *config)
+{
+    keypad_matrix_status_t ret = KEYPAD_MATRIX_INVALID;
+
+    uint32_t row_lines = 0u;
+    uint32_t port      = 0u;
+    uint32_t ticks     = 0u;
+    uint32_t prescaler = 0u;
+    uint8_t  index     = 0u;
+
+    if ((config->row_count == 0u) || (config->row_count > KEYPAD_MATRIX_MAX_LINES) ||
+        (config->col_count == 0u) || (config->col_count > KEYPAD_MATRIX_MAX_LINES) ||
+        (((uint32_t)config->row_shift + config->row_count) > 16u) ||
+        (((uint32_t)config->col_shift + config->col_count) > 16u) ||
+        (config->scan_hz == 0u))
+    {
+        goto end_of_function;
+    }
+
+    row_lines         = (((1UL << config->row_count) - 1u) << config->row_shift);
+    keypad->col_lines = (((1UL << config->col_count) - 1u) << config->col_shift);
+
+    if ((config->row_port == config->col_port) && ((row_lines & keypad->col_lines) != 0u))
+    {
+        goto end_of_function;
+    }
+
+    ticks = (config->timer_clock_hz / (config->scan_hz * config->row_count));
+
+    if (ticks < 2u)
+    {
+        goto end_of_function;
+    }
+
+    prescaler = ((ticks - 1u) / KEYPAD_MATRIX_TIMER_MAX);
+
+    if (prescaler >= KEYPAD_MATRIX_TIMER_MAX)
+    {
+        goto end_of_function;
+    }
+
+    /* Runtime state ---------------------------------------------------------*/
+    keypad->timer       = config->timer;
+    keypad->row_port    = config->row_port;
+    keypad->col_port    = config->col_port;
+    keypad->col_shift   = config->col_shift;
+    keypad->col_count   = config->col_count;
+    keypad->row_count   = config->row_count;
+    keypad->idle_frames = config->idle_frames;
+    keypad->on_frame    = config->on_frame;
+    keypad->context     = config->context;
+    keypad->state       = 0u;
+    keypad->frames      = 0u;
+    keypad->idle_word   = GPIO_BSRR_WORD(row_lines, 0u);
+
+    for (index = 0u; index < KEYPAD_MATRIX_MAX_LINES; index++)
+    {
+        keypad->row_word[index] = GPIO_BSRR_WORD(row_lines, ~(1UL << (config->row_shift + index)));
+    }
+
+    /* Rows open-drain released, columns pulled up ---------------------------*/
+    config->row_port->BSRR = GPIO_BSRR_WORD(row_lines, row_lines);
+
+    gpioRegisterUpdate(&config->row_port->OTYPER, row_lines, row_lines);
+    gpioRegisterUpdate(&config->row_port->MODER, (GPIO_SPREAD2(row_lines) * 3u),
+                       (GPIO_SPREAD2(row_lines) * GPIO_MODE_OUTPUT));
+
+    gpioRegisterUpdate(&config->col_port->PUPDR, (GPIO_SPREAD2(keypad->col_lines) * 3u),
+                       (GPIO_SPREAD2(keypad->col_lines) * GPIO_PULL_UP));
+    gpioRegisterUpdate(&config->col_port->MODER, (GPIO_SPREAD2(keypad->col_lines) * 3u),
+                       (GPIO_SPREAD2(keypad->col_lines) * GPIO_MODE_INPUT));
+
+    /* Row scan timer, stopped -----------------------------------------------*/
+    config->timer->CR1  = 0u;
+    config->timer->PSC  = prescaler;
+    config->timer->ARR  = ((ticks / (prescaler + 1u)) - 1u);
+    config->timer->EGR  = TIM_EGR_UG;
+    config->timer->SR   = ~TIM_SR_UIF;
+    config->timer->DIER = TIM_DIER_UIE;
+    config->timer->CR1  = TIM_CR1_ARPE;
+
+    NVIC_SetPriority(config->timer_irq, config->priority);
+    NVIC_ClearPendingIRQ(config->timer_irq);
+    NVIC_EnableIRQ(config->timer_irq);
+
+    /* Column lines to EXTI, falling edge ------------------------------------*/
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+
+    port = (((uint32_t)(uintptr_t)config->col_port - GPIOA_BASE) / KEYPAD_MATRIX_PORT_STRIDE);
+
+    for (index = config->col_shift; index < (config->col_shift + config->col_count); index++)
+    {
+        SYSCFG->EXTICR[index >> 2u] =
+        (
+            (SYSCFG->EXTICR[index >> 2u] & ~(0xFUL << ((index & 3u) * 4u))) |
+            (port << ((index & 3u) * 4u))
+        );
+
+        NVIC_SetPriority(keypadMatrixExtiIrq(index), config->priority);
+        NVIC_ClearPendingIRQ(keypadMatrixExtiIrq(index));
+        NVIC_EnableIRQ(keypadMatrixExtiIrq(index));
+    }
+
+    EXTI->RTSR &= ~keypad->col_lines;
+    EXTI->FTSR |= keypad->col_lines;
+
+    /* Armed, or scanning for good -------------------------------------------*/
+    if (config->idle_frames != 0u)
+    {
+        keypadMatrixEnterIdle(keypad);
+    }
+    else
+    {
+        keypadMatrixStartScan(keypad);
+    }
+
+    ret = KEYPAD_MATRIX_OK;
+
+end_of_function:
+    return ret;
+}
+
+#endif /* KEYPAD_MATRIX_H_ */
+/* end of file */
@@ -0,0 +1,104 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes mem_placement
+ *
+ *  @package    mem_placement
+ *  @brief      This module provides the opt-in placement of the lookup tables
+ *              and of the hot ISR code in RAM, selected at build time.
+ *
+ *  @details    By default every table is const data in flash and every handler
+ *              runs from flash, both fetched through the ART accelerator. Under
+ *              a high refresh rate, or with the flash wait states of a low
+ *              clock profile, table loads then compete with instruction fetches
+ *              on the flash interface. The two selectors below move them out:
+ *
+ *              - **MEM_PLACEMENT_TABLES**: the display, dimming and popcount
+ *                tables go to `.ccmram.tables` (MEM_PLACEMENT_CCM) or to
+ *                `.data.tables` (MEM_PLACEMENT_SRAM). Both are copied from
+ *                flash by the startup code before main(). CCM RAM is zero wait
+ *                state on the core data bus and never shared with a DMA, but a
+ *                DMA stream can not read a table from there.
+ *
+ *              - **MEM_PLACEMENT_CODE**: functions marked with
+ *                MEM_FAST_CODE_SECTION go to `.ramfunc` (MEM_PLACEMENT_SRAM),
+ *                copied along with .data. CCM RAM is not on the instruction
+ *                bus, so MEM_PLACEMENT_CCM is rejected here. The marked
+ *                functions are `long_call`, since SRAM is out of BL range from
+ *                flash; calls from RAM back into flash go through linker
+ *                veneers.
+ *
+ *              The inline IRQ helpers of the modules (e.g. displayMuxIrqHandler())
+ *              follow the handler they are inlined into, so marking the
+ *              application handler is enough to move a whole refresh path.
+ *
+ *              The tables stay `const` for the compiler in every placement. In
+ *              RAM, a stray write can still corrupt them until the next reset.
+ *
+ *  @file       mem_placement.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef MEM_PLACEMENT_H_
+#define MEM_PLACEMENT_H_
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/* Placements, kept as plain literals so they can be tested by #if */
+#define MEM_PLACEMENT_FLASH     0u
+#define MEM_PLACEMENT_CCM       1u
+#define MEM_PLACEMENT_SRAM      2u
+
+#ifndef MEM_PLACEMENT_TABLES
+#define MEM_PLACEMENT_TABLES    MEM_PLACEMENT_FLASH
+#endif
+
+#ifndef MEM_PLACEMENT_CODE
+#define MEM_PLACEMENT_CODE      MEM_PLACEMENT_FLASH
+#endif
+
+#if (MEM_PLACEMENT_TABLES != MEM_PLACEMENT_FLASH) && (MEM_PLACEMENT_TABLES != MEM_PLACEMENT_CCM) && \
+    (MEM_PLACEMENT_TABLES != MEM_PLACEMENT_SRAM)
+#error "MEM_PLACEMENT_TABLES must be MEM_PLACEMENT_FLASH, MEM_PLACEMENT_CCM or MEM_PLACEMENT_SRAM"
+#endif
+
+#if (MEM_PLACEMENT_CODE == MEM_PLACEMENT_CCM)
+#error "CCM RAM is not on the instruction bus, use MEM_PLACEMENT_SRAM for code"
+#endif
+
+#if (MEM_PLACEMENT_CODE != MEM_PLACEMENT_FLASH) && (MEM_PLACEMENT_CODE != MEM_PLACEMENT_SRAM)
+#error "MEM_PLACEMENT_CODE must be MEM_PLACEMENT_FLASH or MEM_PLACEMENT_SRAM"
+#endif
+
+/**
+ * @def MEM_TABLE_SECTION
+ * @package    mem_placement
+ * @brief Places a lookup table as selected by MEM_PLACEMENT_TABLES.
+ */
+#if (MEM_PLACEMENT_TABLES == MEM_PLACEMENT_CCM)
+#define MEM_TABLE_SECTION       __attribute__((section(".ccmram.tables")))
+#elif (MEM_PLACEMENT_TABLES == MEM_PLACEMENT_SRAM)
+#define MEM_TABLE_SECTION       __attribute__((section(".data.tables")))
+#else
+#define MEM_TABLE_SECTION
+#endif
+
+/**
+ * @def MEM_FAST_CODE_SECTION
+ * @package    mem_placement
+ * @brief Places a function as selected by MEM_PLACEMENT_CODE.
+ *
+ * @details To be put on the prototype, so every caller sees `long_call`.
+ */
+#if (MEM_PLACEMENT_CODE == MEM_PLACEMENT_SRAM)
+#define MEM_FAST_CODE_SECTION   __attribute__((section(".ramfunc"), long_call))
+#else
+#define MEM_FAST_CODE_SECTION
+#endif
+
+#endif /* MEM_PLACEMENT_H_ */
+/* end of file */
@@ -0,0 +1,187 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes output_stage
+ *
+ *  @package    output_stage
+ *  @brief      This module provides a change-detection output stage: a bus
+ *              write is only issued when the value to commit differs from the
+ *              last committed one.
+ *
+ *  @details    A polling loop recomputes its outputs on every pass, but they
+ *              rarely change. Storing the same BSRR word or the same segment
+ *              code again costs an AHB write, and competes with the DMA
+ *              streams refreshing the displays for the same bus.
+ *
+ *              - **Committed state**: each output keeps the last value it
+ *                wrote. For a GPIO it is a caller-owned word, for a display it
+ *                is the frame buffer slot itself, so no shadow copy is needed.
+ *
+ *              - **Counters**: every commit request is counted either as a
+ *                commit (value changed, bus written) or as a skip. Several
+ *                outputs can share one `output_stats_t`, which the debugger
+ *                reads to check the savings.
+ *
+ *              - **First write**: a committed word starts at OUTPUT_STAGE_NONE,
+ *                which no BSRR word built by GPIO_BSRR_WORD and no 8-bit code
+ *                can equal, so the first request always reaches the bus.
+ *
+ *              An output and its committed word must be written from a single
+ *              context, like the port pins they stand for.
+ *
+ *  @file       output_stage.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef OUTPUT_STAGE_H_
+#define OUTPUT_STAGE_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+#include "gpio_output.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def OUTPUT_STAGE_NONE
+ * @package    output_stage
+ * @brief Committed value of an output never written.
+ *
+ * @details Sets and resets every pin at once, which GPIO_BSRR_WORD never
+ *          produces, and does not fit in a segment code.
+ */
+#define OUTPUT_STAGE_NONE           (uint32_t)(0xFFFFFFFFU)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @struct  outputStats
+ *  @typedef output_stats_t
+ *  @package    output_stage
+ *
+ *  @brief   Commit counters of one or more outputs.
+ */
+typedef struct outputStats
+{
+    volatile uint32_t commits;      /**< Requests that changed the output */
+    volatile uint32_t skips;        /**< Requests equal to the committed value */
+} output_stats_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         outputStageChanged
+ *  @package    output_stage
+ *
+ *  @brief      Compares a value against the committed one and counts the result.
+ *
+ *  @details    On a change the value becomes the committed one; the caller then
+ *              issues the bus write.
+ *
+ *  @param      stats     [in] : Counters of the output.
+ *  @param      committed [in] : Last committed value, OUTPUT_STAGE_NONE at first.
+ *  @param      value     [in] : Value to be committed.
+ *
+ *  @return     1u if the output has to be written, 0u if it already holds `value`.
+ */
+static inline uint8_t outputStageChanged(output_stats_t *stats, uint32_t *committed, uint32_t value)
+{
+    uint8_t ret = 0u;
+
+    if (*committed == value)
+    {
+        stats->skips++;
+        goto end_of_function;
+    }
+
+    *committed = value;
+    stats->commits++;
+
+    ret = 1u;
+
+end_of_function:
+    return ret;
+}
+
+/**
+ *  @fn         outputStageBsrrWrite
+ *  @package    output_stage
+ *
+ *  @brief      Stores a BSRR word into a port only when it differs from the
+ *              last one committed.
+ *
+ *  @details    Only valid while no one else drives the pins of `bsrr_word`,
+ *              since the port is never read back.
+ *
+ *  @param      stats     [in] : Counters of the output.
+ *  @param      committed [in] : Last word stored, OUTPUT_STAGE_NONE at first.
+ *  @param      port      [in] : GPIO port to be driven.
+ *  @param      bsrr_word [in] : Word built by GPIO_BSRR_WORD or gpioBsrrFromTable.
+ *
+ *  @return     1u if the word was stored, 0u if the store was skipped.
+ */
+static inline uint8_t outputStageBsrrWrite(output_stats_t *stats, uint32_t *committed,
+                                           GPIO_TypeDef *port, uint32_t bsrr_word)
+{
+    uint8_t ret = outputStageChanged(stats, committed, bsrr_word);
+
+    if (ret != 0u)
+    {
+        gpioBsrrWrite(port, bsrr_word);
+    }
+
+    return ret;
+}
+
+/**
+ *  @fn         outputStageCodeChanged
+ *  @package    output_stage
+ *
+ *  @brief      Compares a segment code against a display frame slot.
+ *
+ *  @details    The frame slot is the committed state, so this only reads it.
+ *              On a change the caller runs the backend write, e.g.
+ *              displayDmaWrite(), which fills the slot and its derived words.
+ *
+ *  @param      stats [in] : Counters of the display.
+ *  @param      slot  [in] : Frame byte of the digit, e.g. &mux.back->code[digit].
+ *  @param      code  [in] : Segment code to be shown.
+ *
+ *  @return     1u if the digit has to be written, 0u if it already shows `code`.
+ */
+static inline uint8_t outputStageCodeChanged(output_stats_t *stats, volatile const uint8_t *slot,
+                                             uint8_t code)
+{
+    uint8_t ret = 0u;
+
+    if (*slot == code)
+    {
+        stats->skips++;
+        goto end_of_function;
+    }
+
+    stats->commits++;
+
+    ret = 1u;
+
+end_of_function:
+    return ret;
+}
+
+#endif /* OUTPUT_STAGE_H_ */
+/* end of file */
@@ -0,0 +1,539 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes parity
+ *
+ *  @package    parity
+ *  @brief      This module provides constant-time parity and popcount kernels
+ *              for evaluating key and bit patterns on Cortex-M4 microcontrollers.
+ *
+ *  @details    Every kernel in this module runs the same instruction sequence
+ *              whatever bits are set, so the latency of an input evaluation does
+ *              not depend on which keys are pressed. Four parity strategies are
+ *              available and one of them is selected at build time through
+ *              `PARITY_KERNEL`:
+ *
+ *              - **PARITY_KERNEL_LUT**: one byte load from `popcount_table`, a
+ *                256-entry table generated at compile time and kept in flash.
+ *
+ *              - **PARITY_KERNEL_NIBBLE**: folds the byte to a nibble and uses
+ *                the 16-bit constant 0x6996 as an in-register parity table.
+ *
+ *              - **PARITY_KERNEL_XOR_FOLD**: halves the word with shifted XORs
+ *                down to a nibble, then finishes like the nibble kernel.
+ *
+ *              - **PARITY_KERNEL_BUILTIN**: `__builtin_parity`. ARMv7-M has no
+ *                parity instruction, so GCC lowers it to libgcc `__paritysi2`,
+ *                which is itself an XOR fold plus the call overhead.
+ *
+ *              Cycle counts below are for a Cortex-M4 running from zero
+ *              wait-state memory, excluding call overhead (the kernels are
+ *              meant to be inlined). Table loads from flash add the configured
+ *              FLASH->ACR latency on an ART cache miss.
+ *
+ *              | Kernel          | Instructions                      | Cycles |
+ *              |-----------------|-----------------------------------|--------|
+ *              | parityLut8      | LDR (table), LDRB, AND            | 5      |
+ *              | parityNibble8   | EOR lsr, AND, MOVW, LSR, AND      | 5      |
+ *              | parityXorFold32 | 3x EOR lsr, AND, MOVW, LSR, AND   | 7      |
+ *              | parityBuiltin32 | BL + __paritysi2 + return         | ~12    |
+ *              | popcountLut8    | LDR (table), LDRB                 | 4      |
+ *              | popcountSwar32  | 3 SWAR steps, MUL, LSR            | 12     |
+ *
+ *              The lane kernels evaluate four 8-bit key groups packed in one
+ *              word (a 32-bit IDR read, or several ports merged), lane `k`
+ *              being bits 8k..8k+7. Their shifts and masks never carry across
+ *              a lane, so all four groups are done by the same instructions.
+ *              With `PARITY_SWAR_DSP` the totals and the per-lane selects use
+ *              the Cortex-M4 SIMD instructions USAD8/USADA8, UADD8 and SEL; the host
+ *              and other cores build the portable C equivalents instead.
+ *
+ *              | Kernel             | Instructions                        | Cycles |
+ *              |--------------------|-------------------------------------|--------|
+ *              | parityLanes8x4     | 3x EOR lsr, AND                     | 4      |
+ *              | parityLanesMask4   | parityLanes8x4, MOVW/MOVT, MUL, LSR | 8      |
+ *              | parityLanesSelect  | parityLanes8x4, MOV, UADD8, SEL     | 7      |
+ *              | popcountLanes8x4   | 3 SWAR steps without multiply       | 9      |
+ *              | popcountLanesTotal | USAD8                               | 1      |
+ *
+ *              popcountArray32() sums the lanes of up to PARITY_SWAR_BLOCK
+ *              words in one register before each USADA8, about 10 cycles per
+ *              word, i.e. four 8-bit groups per 2.5 cycles.
+ *
+ *  @file       parity.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef PARITY_H_
+#define PARITY_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+#if defined(__ARM_FEATURE_SIMD32)
+#include <arm_acle.h>
+#endif
+
+/* Implementeds */
+#include "mem_placement.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def MAX_POPCOUNT_TABLE
+ * @package    parity
+ * @brief Number of entries of the byte popcount table.
+ */
+#define MAX_POPCOUNT_TABLE          (uint16_t)(256U)
+
+/**
+ * @def PARITY_LUT_NIBBLE
+ * @package    parity
+ * @brief Parity of every 4-bit value packed in one 16-bit constant.
+ *
+ * @details Bit `n` of this constant holds the parity of `n`, for n = 0..15.
+ */
+#define PARITY_LUT_NIBBLE           (uint32_t)(0x6996U)
+
+/* Parity kernels, kept as plain literals so they can be tested by #if */
+#define PARITY_KERNEL_LUT           0u
+#define PARITY_KERNEL_NIBBLE        1u
+#define PARITY_KERNEL_XOR_FOLD      2u
+#define PARITY_KERNEL_BUILTIN       3u
+
+/**
+ * @def PARITY_KERNEL
+ * @package    parity
+ * @brief Kernel used by parity8() and parity32().
+ *
+ * @details Defaults to the nibble kernel, which needs no memory access and is
+ *          as fast as the table on a flash wait-state.
+ */
+#ifndef PARITY_KERNEL
+#define PARITY_KERNEL               PARITY_KERNEL_NIBBLE
+#endif
+
+/**
+ * @def PARITY_SWAR_DSP
+ * @package    parity
+ * @brief 1u builds the lane kernels on the SIMD instructions, 0u in plain C.
+ *
+ * @details Defaults to 1u when the compiler targets the ARMv7E-M DSP
+ *          extension (-mcpu=cortex-m4), 0u on any other target.
+ */
+#ifndef PARITY_SWAR_DSP
+#if defined(__ARM_FEATURE_SIMD32)
+#define PARITY_SWAR_DSP             1u
+#else
+#define PARITY_SWAR_DSP             0u
+#endif
+#endif
+
+#if ((PARITY_SWAR_DSP == 1u) && !defined(__ARM_FEATURE_SIMD32))
+#error "PARITY_SWAR_DSP needs a target with the DSP extension"
+#endif
+
+/**
+ * @def PARITY_SWAR_LANES
+ * @package    parity
+ * @brief 8-bit lanes packed in a word by the lane kernels.
+ */
+#define PARITY_SWAR_LANES           (uint32_t)(4U)
+
+/**
+ * @def PARITY_SWAR_BLOCK
+ * @package    parity
+ * @brief Words whose lane popcounts can be added in one register.
+ *
+ * @details A lane counts at most 8 bits per word, so 31 words stay below
+ *          256 and never carry into the next lane.
+ */
+#define PARITY_SWAR_BLOCK           (uint32_t)(31U)
+
+/*==========================================
+ *             Private Macros
+ * ========================================== */
+
+/**
+ * @def POPCOUNT_B2
+ * @package    parity
+ * @brief Expands the popcounts of 4 consecutive values starting at bit count `n`.
+ *
+ * @details `POPCOUNT_B2`, `POPCOUNT_B4` and `POPCOUNT_B6` expand recursively,
+ *          so the 256 table entries are produced by the preprocessor.
+ */
+#define POPCOUNT_B2(n)              (n), (n) + 1, (n) + 1, (n) + 2
+#define POPCOUNT_B4(n)              POPCOUNT_B2(n), POPCOUNT_B2((n) + 1), \
+                                    POPCOUNT_B2((n) + 1), POPCOUNT_B2((n) + 2)
+#define POPCOUNT_B6(n)              POPCOUNT_B4(n), POPCOUNT_B4((n) + 1), \
+                                    POPCOUNT_B4((n) + 1), POPCOUNT_B4((n) + 2)
+
+/*==========================================
+ *         Private Global Variables
+ * ========================================== */
+
+/**
+ *  @var popcount_table
+ *  @package    parity
+ *
+ *  @brief  Number of '1' bits of every 8-bit value.
+ *
+ *  @details
+ *  Generated at compile time. Bit 0 of each entry is the parity of its index,
+ *  so the same table serves both popcountLut8() and parityLut8().
+ */
+const uint8_t popcount_table[MAX_POPCOUNT_TABLE] __attribute__((weak, used, aligned(4))) MEM_TABLE_SECTION =
+{
+    POPCOUNT_B6(0), POPCOUNT_B6(1), POPCOUNT_B6(1), POPCOUNT_B6(2)
+};
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         popcountLut8
+ *  @package    parity
+ *
+ *  @brief      Counts the '1' bits of a byte through `popcount_table`.
+ *
+ *  @param      value [in] : The 8-bit value to be evaluated.
+ *
+ *  @return     Number of '1' bits, 0..8.
+ */
+static inline uint8_t popcountLut8(uint8_t value)
+{
+    return popcount_table[value];
+}
+
+/**
+ *  @fn         popcountSwar32
+ *  @package    parity
+ *
+ *  @brief      Counts the '1' bits of a word with SIMD-within-a-register sums.
+ *
+ *  @details    Adds adjacent bit pairs, then nibbles, then bytes in parallel
+ *              and gathers the four byte sums with one multiply.
+ *
+ *  @param      value [in] : The 32-bit value to be evaluated.
+ *
+ *  @return     Number of '1' bits, 0..32.
+ */
+static inline uint8_t popcountSwar32(uint32_t value)
+{
+    value = value - ((value >> 1u) & 0x55555555UL);
+    value = (value & 0x33333333UL) + ((value >> 2u) & 0x33333333UL);
+    value = (value + (value >> 4u)) & 0x0F0F0F0FUL;
+
+    return (uint8_t)((value * 0x01010101UL) >> 24u);
+}
+
+/**
+ *  @fn         parityLut8
+ *  @package    parity
+ *
+ *  @brief      Parity of a byte read from `popcount_table`.
+ *
+ *  @param      value [in] : The 8-bit value to be evaluated.
+ *
+ *  @return     0 if the number of '1' bits is even, 1 if it is odd.
+ */
+static inline uint8_t parityLut8(uint8_t value)
+{
+    return (uint8_t)(popcount_table[value] & 1u);
+}
+
+/**
+ *  @fn         parityNibble8
+ *  @package    parity
+ *
+ *  @brief      Parity of a byte using `PARITY_LUT_NIBBLE` as an in-register table.
+ *
+ *  @param      value [in] : The 8-bit value to be evaluated.
+ *
+ *  @return     0 if the number of '1' bits is even, 1 if it is odd.
+ */
+static inline uint8_t parityNibble8(uint8_t value)
+{
+    uint32_t folded = ((uint32_t)value ^ ((uint32_t)value >> 4u)) & 0xFu;
+
+    return (uint8_t)((PARITY_LUT_NIBBLE >> folded) & 1u);
+}
+
+/**
+ *  @fn         parityXorFold32
+ *  @package    parity
+ *
+ *  @brief      Parity of a word folded down to a nibble with shifted XORs.
+ *
+ *  @param      value [in] : The 32-bit value to be evaluated.
+ *
+ *  @return     0 if the number of '1' bits is even, 1 if it is odd.
+ */
+static inline uint8_t parityXorFold32(uint32_t value)
+{
+    value ^= (value >> 16u);
+    value ^= (value >> 8u);
+    value ^= (value >> 4u);
+
+    return (uint8_t)((PARITY_LUT_NIBBLE >> (value & 0xFu)) & 1u);
+}
+
+/**
+ *  @fn         parityBuiltin32
+ *  @package    parity
+ *
+ *  @brief      Parity of a word through the compiler builtin.
+ *
+ *  @param      value [in] : The 32-bit value to be evaluated.
+ *
+ *  @return     0 if the number of '1' bits is even, 1 if it is odd.
+ */
+static inline uint8_t parityBuiltin32(uint32_t value)
+{
+    return (uint8_t)__builtin_parity(value);
+}
+
+/**
+ *  @fn         parity8
+ *  @package    parity
+ *
+ *  @brief      Parity of a byte with the kernel selected by `PARITY_KERNEL`.
+ *
+ *  @param      value [in] : The 8-bit value to be evaluated.
+ *
+ *  @return     0 if the number of '1' bits is even, 1 if it is odd.
+ */
+static inline uint8_t parity8(uint8_t value)
+{
+#if (PARITY_KERNEL == PARITY_KERNEL_LUT)
+    return parityLut8(value);
+#elif (PARITY_KERNEL == PARITY_KERNEL_NIBBLE)
+    return parityNibble8(value);
+#elif (PARITY_KERNEL == PARITY_KERNEL_XOR_FOLD)
+    return parityXorFold32((uint32_t)value);
+#elif (PARITY_KERNEL == PARITY_KERNEL_BUILTIN)
+    return parityBuiltin32((uint32_t)value);
+#else
+#error "Unknown PARITY_KERNEL"
+#endif
+}
+
+/**
+ *  @fn         parity32
+ *  @package    parity
+ *
+ *  @brief      Parity of a word with the kernel selected by `PARITY_KERNEL`.
+ *
+ *  @details    The byte-wide kernels are applied after folding the word to
+ *              one byte, which keeps the sequence constant-time.
+ *
+ *  @param      value [in] : The 32-bit value to be evaluated.
+ *
+ *  @return     0 if the number of '1' bits is even, 1 if it is odd.
+ */
+static inline uint8_t parity32(uint32_t value)
+{
+#if (PARITY_KERNEL == PARITY_KERNEL_BUILTIN)
+    return parityBuiltin32(value);
+#elif (PARITY_KERNEL == PARITY_KERNEL_XOR_FOLD)
+    return parityXorFold32(value);
+#else
+    value ^= (value >> 16u);
+    value ^= (value >> 8u);
+
+    return parity8((uint8_t)value);
+#endif
+}
+
+/**
+ *  @fn         parityLanes8x4
+ *  @package    parity
+ *
+ *  @brief      Parity of each of the four bytes of a word.
+ *
+ *  @details    Folds every byte onto its bit 0. Bits shifted in from the
+ *              byte above only reach bits 1..7, which the mask drops.
+ *
+ *  @param      value [in] : Four 8-bit groups, lane `k` in bits 8k..8k+7.
+ *
+ *  @return     0 or 1 in bit 0 of each lane, every other bit cleared.
+ */
+static inline uint32_t parityLanes8x4(uint32_t value)
+{
+    value ^= (value >> 4u);
+    value ^= (value >> 2u);
+    value ^= (value >> 1u);
+
+    return (value & 0x01010101UL);
+}
+
+/**
+ *  @fn         parityLanesMask4
+ *  @package    parity
+ *
+ *  @brief      Parities of the four bytes of a word gathered in a nibble.
+ *
+ *  @details    The multiply moves lane `k` to bit 24 + k. No partial product
+ *              exceeds a nibble, so nothing carries into the result byte.
+ *
+ *  @param      value [in] : Four 8-bit groups, lane `k` in bits 8k..8k+7.
+ *
+ *  @return     Parity of lane `k` in bit `k`, 0x0..0xF.
+ */
+static inline uint8_t parityLanesMask4(uint32_t value)
+{
+    return (uint8_t)((parityLanes8x4(value) * 0x01020408UL) >> 24u);
+}
+
+/**
+ *  @fn         parityLanesSelect
+ *  @package    parity
+ *
+ *  @brief      Picks, for each lane, a byte of `odd` or of `even` after the
+ *              parity of the same lane of `value`.
+ *
+ *  @details    Builds e.g. four LED or segment codes in one word. On the DSP
+ *              path UADD8 adds 0xFF to every lane, which carries, and so sets
+ *              its GE flag, exactly for an odd lane; SEL then merges the two
+ *              words by those flags.
+ *
+ *  @param      value [in] : Four 8-bit groups, lane `k` in bits 8k..8k+7.
+ *  @param      odd   [in] : Bytes taken by the odd lanes.
+ *  @param      even  [in] : Bytes taken by the even lanes.
+ *
+ *  @return     The merged word.
+ */
+static inline uint32_t parityLanesSelect(uint32_t value, uint32_t odd, uint32_t even)
+{
+    uint32_t lanes = parityLanes8x4(value);
+
+#if (PARITY_SWAR_DSP == 1u)
+    (void)__uadd8(lanes, 0xFFFFFFFFUL);
+
+    return __sel(odd, even);
+#else
+    uint32_t mask = (lanes * 0xFFu);
+
+    return (even ^ ((odd ^ even) & mask));
+#endif
+}
+
+/**
+ *  @fn         popcountLanes8x4
+ *  @package    parity
+ *
+ *  @brief      Number of '1' bits of each of the four bytes of a word.
+ *
+ *  @details    The first three steps of popcountSwar32(), without the multiply
+ *              that gathers the lanes.
+ *
+ *  @param      value [in] : Four 8-bit groups, lane `k` in bits 8k..8k+7.
+ *
+ *  @return     Popcount of lane `k`, 0..8, in the same lane.
+ */
+static inline uint32_t popcountLanes8x4(uint32_t value)
+{
+    value = value - ((value >> 1u) & 0x55555555UL);
+    value = (value & 0x33333333UL) + ((value >> 2u) & 0x33333333UL);
+
+    return ((value + (value >> 4u)) & 0x0F0F0F0FUL);
+}
+
+/**
+ *  @fn         popcountLanesTotal
+ *  @package    parity
+ *
+ *  @brief      Sum of the four byte lanes of a word.
+ *
+ *  @details    USAD8 against zero adds the four bytes in one cycle. The C
+ *              fallback adds the byte pairs, then the halfwords.
+ *
+ *  @param      lanes [in] : Four byte counters, e.g. from popcountLanes8x4().
+ *
+ *  @return     Sum of the four lanes, 0..1020.
+ */
+static inline uint32_t popcountLanesTotal(uint32_t lanes)
+{
+#if (PARITY_SWAR_DSP == 1u)
+    return __usad8(lanes, 0u);
+#else
+    lanes = (lanes & 0x00FF00FFUL) + ((lanes >> 8u) & 0x00FF00FFUL);
+
+    return ((lanes + (lanes >> 16u)) & 0xFFFFu);
+#endif
+}
+
+/**
+ *  @fn         parityLanesArray
+ *  @package    parity
+ *
+ *  @brief      Parities of an array of samples, four 8-bit groups per word.
+ *
+ *  @param      words    [in]  : Samples, four groups each.
+ *  @param      parities [out] : parityLanes8x4() of every sample, may be `words`.
+ *  @param      count    [in]  : Number of words.
+ */
+static inline void parityLanesArray(const uint32_t *words, uint32_t *parities, uint32_t count)
+{
+    for (uint32_t index = 0u; index < count; index++)
+    {
+        parities[index] = parityLanes8x4(words[index]);
+    }
+}
+
+/**
+ *  @fn         popcountArray32
+ *  @package    parity
+ *
+ *  @brief      Total number of '1' bits of an array of words.
+ *
+ *  @details    The lane popcounts of up to PARITY_SWAR_BLOCK words are added
+ *              in one register, then folded into the total, with USADA8 on
+ *              the DSP path. The running time only depends on `count`.
+ *
+ *  @param      words [in] : Words to be evaluated.
+ *  @param      count [in] : Number of words.
+ *
+ *  @return     Number of '1' bits of the whole array.
+ */
+static inline uint32_t popcountArray32(const uint32_t *words, uint32_t count)
+{
+    uint32_t total = 0u;
+    uint32_t index = 0u;
+
+    while (index < count)
+    {
+        uint32_t block = (count - index);
+        uint32_t lanes = 0u;
+
+        if (block > PARITY_SWAR_BLOCK)
+        {
+            block = PARITY_SWAR_BLOCK;
+        }
+
+        for (uint32_t end = (index + block); index < end; index++)
+        {
+            lanes += popcountLanes8x4(words[index]);
+        }
+
+#if (PARITY_SWAR_DSP == 1u)
+        total = __usada8(lanes, 0u, total);
+#else
+        total += popcountLanesTotal(lanes);
+#endif
+    }
+
+    return total;
+}
+
+#endif /* PARITY_H_ */
+/* end of file */
@@ -0,0 +1,176 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes rules_table
+ *
+ *  @package    rules_table
+ *  @brief      This module provides compile-time generated lookup tables that
+ *              map an N-bit input word straight to a 32-bit output word.
+ *
+ *  @details    A combinational rule from keys to outputs is written once as a
+ *              macro of the input value, and the preprocessor expands it for
+ *              every one of the 2^N inputs into a const table. At run time the
+ *              rule is a mask and one load, whatever the logic behind it, and
+ *              the output word is stored as-is:
+ *
+ *              - **Outputs**: an entry is any 32-bit constant, e.g. a BSRR
+ *                word built with GPIO_BSRR_WORD for LEDs, or a segment code of
+ *                `display_segments.h` for a digit.
+ *
+ *              - **Rules**: a rule is a function-like macro `rule(input)` that
+ *                has to be a constant expression. RULES_BIT, RULES_PARITY8 and
+ *                RULES_POPCOUNT8 are constant building blocks for them.
+ *
+ *              - **Size**: a table holds 2^N words, up to RULES_MAX_INPUTS
+ *                inputs (1 KB). Wider inputs are folded or split over several
+ *                tables first.
+ *
+ *              | Inputs | Entries | Flash   |
+ *              |--------|---------|---------|
+ *              | 3      | 8       | 32 B    |
+ *              | 4      | 16      | 64 B    |
+ *              | 8      | 256     | 1024 B  |
+ *
+ *              The tables follow MEM_PLACEMENT_TABLES like the other lookup
+ *              tables of `inc/`.
+ *
+ *  @file       rules_table.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef RULES_TABLE_H_
+#define RULES_TABLE_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "mem_placement.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def RULES_MAX_INPUTS
+ * @package    rules_table
+ * @brief Widest input of one table, RULES_EXPAND_8.
+ */
+#define RULES_MAX_INPUTS            (uint8_t)(8U)
+
+/*==========================================
+ *             Private Macros
+ * ========================================== */
+
+/**
+ * @def RULES_INPUT_MASK
+ * @package    rules_table
+ * @brief Input bits of a table of `inputs` inputs.
+ */
+#define RULES_INPUT_MASK(inputs)    (uint32_t)((1UL << (inputs)) - 1u)
+
+/**
+ * @def RULES_BIT
+ * @package    rules_table
+ * @brief Bit `n` of a rule input, 0u or 1u.
+ */
+#define RULES_BIT(input, n)         (uint32_t)(((uint32_t)(input) >> (n)) & 1u)
+
+/**
+ * @def RULES_PARITY8
+ * @package    rules_table
+ * @brief Parity of the low byte of a rule input, 1u when odd.
+ *
+ * @details The byte is folded on a nibble, whose parity is bit `nibble` of
+ *          0x6996, so the macro stays a constant expression.
+ */
+#define RULES_PARITY8(input)                                                   \
+    (uint32_t)((0x6996u >> (((uint32_t)(input) ^ ((uint32_t)(input) >> 4u)) & 0xFu)) & 1u)
+
+/**
+ * @def RULES_POPCOUNT8
+ * @package    rules_table
+ * @brief Number of '1' bits of the low byte of a rule input.
+ */
+#define RULES_POPCOUNT8(input)                                                 \
+    (uint32_t)(RULES_BIT(input, 0u) + RULES_BIT(input, 1u) + RULES_BIT(input, 2u) + \
+               RULES_BIT(input, 3u) + RULES_BIT(input, 4u) + RULES_BIT(input, 5u) + \
+               RULES_BIT(input, 6u) + RULES_BIT(input, 7u))
+
+/**
+ * @def RULES_EXPAND_0
+ * @package    rules_table
+ * @brief Entries `rule(base)` .. `rule(base + 2^n - 1)`, comma separated.
+ *
+ * @details RULES_EXPAND_n doubles RULES_EXPAND_(n-1), so a table of n inputs
+ *          is one RULES_EXPAND_n(rule, 0u).
+ */
+#define RULES_EXPAND_0(rule, base)  rule(base)
+#define RULES_EXPAND_1(rule, base)  RULES_EXPAND_0(rule, (base)), RULES_EXPAND_0(rule, (base) + 1u)
+#define RULES_EXPAND_2(rule, base)  RULES_EXPAND_1(rule, (base)), RULES_EXPAND_1(rule, (base) + 2u)
+#define RULES_EXPAND_3(rule, base)  RULES_EXPAND_2(rule, (base)), RULES_EXPAND_2(rule, (base) + 4u)
+#define RULES_EXPAND_4(rule, base)  RULES_EXPAND_3(rule, (base)), RULES_EXPAND_3(rule, (base) + 8u)
+#define RULES_EXPAND_5(rule, base)  RULES_EXPAND_4(rule, (base)), RULES_EXPAND_4(rule, (base) + 16u)
+#define RULES_EXPAND_6(rule, base)  RULES_EXPAND_5(rule, (base)), RULES_EXPAND_5(rule, (base) + 32u)
+#define RULES_EXPAND_7(rule, base)  RULES_EXPAND_6(rule, (base)), RULES_EXPAND_6(rule, (base) + 64u)
+#define RULES_EXPAND_8(rule, base)  RULES_EXPAND_7(rule, (base)), RULES_EXPAND_7(rule, (base) + 128u)
+
+/**
+ * @def RULES_EXPAND
+ * @package    rules_table
+ * @brief RULES_EXPAND_n from `0u`, with `inputs` expanded before the paste.
+ */
+#define RULES_EXPAND(inputs, rule)  RULES_EXPAND_PASTE(inputs, rule)
+#define RULES_EXPAND_PASTE(inputs, rule) RULES_EXPAND_##inputs(rule, 0u)
+
+/**
+ * @def RULES_TABLE_DEFINE
+ * @package    rules_table
+ * @brief Defines `name`, the 2^inputs words of `rule`.
+ *
+ * @details `inputs` has to be a plain decimal literal (e.g. `3`, not `3u`),
+ *          directly or through a macro, since it names RULES_EXPAND_n. Prefix
+ *          the line with `static` for a private table.
+ *
+ * @param name   Table identifier.
+ * @param inputs Input bits, 0..RULES_MAX_INPUTS.
+ * @param rule   Function-like macro giving the output word of one input.
+ */
+#define RULES_TABLE_DEFINE(name, inputs, rule)                                 \
+    const uint32_t name[1UL << (inputs)] __attribute__((used, aligned(4))) MEM_TABLE_SECTION = \
+    {                                                                          \
+        RULES_EXPAND(inputs, rule)                                             \
+    }
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         rulesLookup
+ *  @package    rules_table
+ *
+ *  @brief      Output word of a rule for one input.
+ *
+ *  @details    With a constant `inputs` this is one AND and one LDR; bits of
+ *              `input` above the table width are ignored.
+ *
+ *  @param      table  [in] : Table built by RULES_TABLE_DEFINE.
+ *  @param      inputs [in] : Input bits of the table.
+ *  @param      input  [in] : Input word, e.g. the keys state.
+ *
+ *  @return     The output word.
+ */
+static inline uint32_t rulesLookup(const uint32_t *table, uint8_t inputs, uint32_t input)
+{
+    return table[input & RULES_INPUT_MASK(inputs)];
+}
+
+#endif /* RULES_TABLE_H_ */
+/* end of file */
@@ -0,0 +1,430 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes scheduler
+ *
+ *  @package    scheduler
+ *  @brief      This module provides a run-to-completion cooperative scheduler of
+ *              periodic tasks on a SysTick time base, with tickless idle.
+ *
+ *  @details    The application owns a table of `sched_task_t`, each with a
+ *              function, a period in ticks and an optional cycle budget, and a
+ *              `scheduler_t` tying the table to SysTick. The main loop only
+ *              alternates schedulerDispatch() and schedulerIdle().
+ *
+ *              - **Dispatch**: every task whose release tick has come runs once,
+ *                to completion, in table order. A task released more than one
+ *                period late is not run repeatedly to catch up; it is counted in
+ *                `late` and re-phased on the current tick.
+ *
+ *              - **Budgets**: each run is timed with the DWT cycle counter into
+ *                the task `cycles` record, and runs longer than `budget_cycles`
+ *                are counted in `overruns`, so the CPU share of every task can
+ *                be read back with the debugger.
+ *
+ *              - **Tickless idle**: with SCHEDULER_TICKLESS, schedulerIdle()
+ *                stretches the SysTick period up to the next release before WFI,
+ *                so an idle core wakes once per task release instead of once per
+ *                tick. An early wake-up by another interrupt is accounted for to
+ *                the cycle, and the partial tick is finished with a shortened
+ *                period. Stopping and restarting SysTick around the sleep costs a
+ *                few cycles of drift per idle period.
+ *
+ *              SysTick runs from the core clock, so one idle period is limited to
+ *              2^24 cycles (about 99 ms at 168 MHz).
+ *
+ *  @file       scheduler.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stddef.h>
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+#include "cycle_bench.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def SCHEDULER_TICKLESS
+ * @package    scheduler
+ * @brief 1u to stretch the SysTick period while idle, 0u to wake on every tick.
+ */
+#ifndef SCHEDULER_TICKLESS
+#define SCHEDULER_TICKLESS          1u
+#endif
+
+/**
+ * @def SCHEDULER_SYSTICK_RANGE
+ * @package    scheduler
+ * @brief Number of cycles the 24-bit SysTick counter can span.
+ */
+#define SCHEDULER_SYSTICK_RANGE     (uint32_t)(SysTick_LOAD_RELOAD_Msk + 1UL)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    schedulerStatus
+ *  @typedef scheduler_status_t
+ *  @package    scheduler
+ *
+ *  @brief   Result of a scheduler request.
+ */
+typedef enum schedulerStatus
+{
+    SCHEDULER_OK        = (uint8_t)(0u),    /**< Time base running */
+    SCHEDULER_INVALID   = (uint8_t)(1u)     /**< Tick rate out of SysTick range */
+} scheduler_status_t;
+
+/**
+ *  @struct  schedTask
+ *  @typedef sched_task_t
+ *  @package    scheduler
+ *
+ *  @brief   One periodic task and its run statistics.
+ *
+ *  @details `next` is the tick of the first release, 0 to run on the first
+ *           dispatch; a different value per task staggers tasks of the same
+ *           period.
+ */
+typedef struct schedTask
+{
+    void        (*run)(void *context);  /**< Task body, runs to completion */
+    void         *context;              /**< Argument of `run` */
+    uint32_t      period;               /**< Ticks between two releases */
+    uint32_t      next;                 /**< Tick of the next release */
+    uint32_t      budget_cycles;        /**< Allowed cycles per run, 0 for none */
+    uint32_t      overruns;             /**< Runs longer than the budget */
+    uint32_t      late;                 /**< Releases missed by a full period */
+    bench_stat_t  cycles;               /**< Cycles of every run */
+} sched_task_t;
+
+/**
+ *  @struct  scheduler
+ *  @typedef scheduler_t
+ *  @package    scheduler
+ *
+ *  @brief   Runtime state of the scheduler.
+ */
+typedef struct scheduler
+{
+    sched_task_t       *tasks;              /**< Task table, in dispatch order */
+    uint8_t             count;              /**< Number of tasks */
+    volatile uint8_t    short_period;       /**< SysTick LOAD to be restored */
+    uint32_t            tick_cycles;        /**< Core cycles per tick */
+    uint32_t            max_idle_ticks;     /**< Longest tickless sleep */
+    volatile uint32_t   now;                /**< Ticks since schedulerStart() */
+    volatile uint32_t   step;               /**< Ticks added by the next SysTick */
+    uint32_t            idle_periods;       /**< Stretched sleeps taken */
+} scheduler_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         schedulerInit
+ *  @package    scheduler
+ *
+ *  @brief      Binds a task table and clears its statistics.
+ *
+ *  @param      scheduler [out]   : Scheduler to be initialised.
+ *  @param      tasks     [inout] : Task table, `run`, `period` and `next` set.
+ *  @param      count     [in]    : Number of tasks.
+ */
+static inline void schedulerInit(scheduler_t *scheduler, sched_task_t *tasks, uint8_t count)
+{
+    uint8_t index = 0u;
+
+    scheduler->tasks          = tasks;
+    scheduler->count          = count;
+    scheduler->short_period   = 0u;
+    scheduler->tick_cycles    = 0u;
+    scheduler->max_idle_ticks = 0u;
+    scheduler->now            = 0u;
+    scheduler->step           = 1u;
+    scheduler->idle_periods   = 0u;
+
+    for (index = 0u; index < count; index++)
+    {
+        tasks[index].overruns   = 0u;
+        tasks[index].late       = 0u;
+        tasks[index].cycles     = (bench_stat_t)BENCH_STAT_INIT;
+    }
+}
+
+/**
+ *  @fn         schedulerStart
+ *  @package    scheduler
+ *
+ *  @brief      Starts the SysTick time base.
+ *
+ *  @param      scheduler [inout] : Initialised scheduler.
+ *  @param      core_hz   [in]    : Core clock, e.g. SystemCoreClock.
+ *  @param      tick_hz   [in]    : Tick rate.
+ *  @param      priority  [in]    : SysTick exception priority.
+ *
+ *  @return     SCHEDULER_OK     : if SysTick is running.
+ *              SCHEDULER_INVALID: if the tick does not fit the 24-bit counter.
+ */
+static inline scheduler_status_t schedulerStart(scheduler_t *scheduler, uint32_t core_hz,
+                                                uint32_t tick_hz, uint32_t priority)
+{
+    scheduler_status_t ret = SCHEDULER_OK;
+
+    uint32_t tick_cycles = (tick_hz != 0u) ? (core_hz / tick_hz) : 0u;
+
+    if ((tick_cycles < 2u) || (tick_cycles > SCHEDULER_SYSTICK_RANGE))
+    {
+        ret = SCHEDULER_INVALID;
+        goto end_of_function;
+    }
+
+    scheduler->tick_cycles    = tick_cycles;
+    scheduler->max_idle_ticks = (SCHEDULER_SYSTICK_RANGE / tick_cycles);
+
+    scheduler->max_idle_ticks = (scheduler->max_idle_ticks > 1u) ? (scheduler->max_idle_ticks - 1u) : 0u;
+
+    (void)benchInit();
+
+    NVIC_SetPriority(SysTick_IRQn, priority);
+
+    SysTick->CTRL = 0u;
+    SysTick->LOAD = (tick_cycles - 1u);
+    SysTick->VAL  = 0u;
+    SysTick->CTRL = (SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk);
+
+end_of_function:
+    return ret;
+}
+
+/**
+ *  @fn         schedulerIrqHandler
+ *  @package    scheduler
+ *
+ *  @brief      Advances the time base, to be called from SysTick_Handler().
+ *
+ *  @details    Adds the ticks covered by the period that just ended and, after
+ *              a shortened period, puts the regular tick back.
+ *
+ *  @param      scheduler [inout] : Running scheduler.
+ */
+static inline void schedulerIrqHandler(scheduler_t *scheduler)
+{
+    scheduler->now += scheduler->step;
+    scheduler->step = 1u;
+
+    if (scheduler->short_period != 0u)
+    {
+        SysTick->LOAD           = (scheduler->tick_cycles - 1u);
+        SysTick->VAL            = 0u;
+        scheduler->short_period = 0u;
+    }
+}
+
+/**
+ *  @fn         schedulerNextRelease
+ *  @package    scheduler
+ *
+ *  @brief      Ticks left until the earliest task release.
+ *
+ *  @param      scheduler [in] : Running scheduler.
+ *
+ *  @return     Ticks to wait, 0 or less when a task is already due.
+ */
+static inline int32_t schedulerNextRelease(const scheduler_t *scheduler)
+{
+    uint32_t now   = scheduler->now;
+    int32_t  ret   = INT32_MAX;
+    int32_t  delta = 0;
+    uint8_t  index = 0u;
+
+    for (index = 0u; index < scheduler->count; index++)
+    {
+        delta = (int32_t)(scheduler->tasks[index].next - now);
+
+        ret   = (delta < ret) ? delta : ret;
+    }
+
+    return ret;
+}
+
+/**
+ *  @fn         schedulerDispatch
+ *  @package    scheduler
+ *
+ *  @brief      Runs every task whose release has come, once.
+ *
+ *  @param      scheduler [inout] : Running scheduler.
+ *
+ *  @return     Number of tasks run.
+ */
+static inline uint32_t schedulerDispatch(scheduler_t *scheduler)
+{
+    uint32_t now    = scheduler->now;
+    uint32_t ran    = 0u;
+    uint32_t stamp  = 0u;
+    uint32_t cycles = 0u;
+    uint8_t  index  = 0u;
+
+    sched_task_t *task = NULL;
+
+    for (index = 0u; index < scheduler->count; index++)
+    {
+        task = &scheduler->tasks[index];
+
+        if ((int32_t)(now - task->next) < 0)
+        {
+            continue;
+        }
+
+        task->next += task->period;
+
+        if ((int32_t)(now - task->next) >= 0)
+        {
+            task->late++;
+            task->next = (now + task->period);
+        }
+
+        stamp  = benchNow();
+
+        task->run(task->context);
+
+        cycles = (benchNow() - stamp);
+
+        benchRecord(&task->cycles, cycles);
+
+        if ((task->budget_cycles != 0u) && (cycles > task->budget_cycles))
+        {
+            task->overruns++;
+        }
+
+        ran++;
+    }
+
+    return ran;
+}
+
+/**
+ *  @fn         schedulerIdle
+ *  @package    scheduler
+ *
+ *  @brief      Sleeps until the next task release or any interrupt.
+ *
+ *  @details    It performs the following actions, with PRIMASK set so that the
+ *              wake-up interrupt only runs once the time base is consistent:
+ *
+ *                  - Returns at once if a task is already due.
+ *                  - With SCHEDULER_TICKLESS and two or more idle ticks, stops
+ *                    SysTick and reloads it to expire on the next release,
+ *                    minus the part of the current tick already elapsed.
+ *                  - Executes WFI.
+ *                  - If SysTick expired, restores the regular tick and lets the
+ *                    pending SysTick add the whole idle period. Otherwise adds
+ *                    the whole ticks slept and finishes the partial one with a
+ *                    shortened period.
+ *
+ *  @param      scheduler [inout] : Running scheduler.
+ */
+static inline void schedulerIdle(scheduler_t *scheduler)
+{
+    uint32_t primask = __get_PRIMASK();
+    int32_t  delta   = 0;
+
+#if (SCHEDULER_TICKLESS == 1u)
+    uint32_t ticks   = 0u;
+    uint32_t into    = 0u;
+    uint32_t elapsed = 0u;
+    uint32_t whole   = 0u;
+    uint32_t rest    = 0u;
+#endif
+
+    __disable_irq();
+
+    delta = schedulerNextRelease(scheduler);
+
+    if (delta <= 0)
+    {
+        goto end_of_function;
+    }
+
+#if (SCHEDULER_TICKLESS == 1u)
+    if ((delta >= 2) && (scheduler->max_idle_ticks >= 2u) && (scheduler->short_period == 0u))
+    {
+        ticks = ((uint32_t)delta < scheduler->max_idle_ticks) ? (uint32_t)delta : scheduler->max_idle_ticks;
+
+        /* Freeze the counter, bail out if the tick boundary just passed -----*/
+        into  = ((scheduler->tick_cycles - 1u) - SysTick->VAL);
+
+        SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+        if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0u)
+        {
+            SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+            goto end_of_function;
+        }
+
+        /* One long period up to the next release ----------------------------*/
+        SysTick->LOAD   = ((ticks * scheduler->tick_cycles) - 1u - into);
+        SysTick->VAL    = 0u;
+        scheduler->step = ticks;
+        scheduler->idle_periods++;
+
+        SysTick->CTRL  |= SysTick_CTRL_ENABLE_Msk;
+
+        __DSB();
+        __WFI();
+
+        SysTick->CTRL  &= ~SysTick_CTRL_ENABLE_Msk;
+
+        if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0u)
+        {
+            /* Slept the whole period, the pending SysTick adds it -----------*/
+            SysTick->LOAD = (scheduler->tick_cycles - 1u);
+        }
+        else
+        {
+            /* Woken early: account the whole ticks, finish the partial one --*/
+            elapsed = ((SysTick->LOAD - SysTick->VAL) + into);
+            whole   = (elapsed / scheduler->tick_cycles);
+            rest    = (elapsed - (whole * scheduler->tick_cycles));
+
+            scheduler->now         += whole;
+            scheduler->step         = 1u;
+            scheduler->short_period = 1u;
+
+            SysTick->LOAD = ((rest < (scheduler->tick_cycles - 2u)) ?
+                             ((scheduler->tick_cycles - 1u) - rest) : 1u);
+        }
+
+        SysTick->VAL   = 0u;
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+        goto end_of_function;
+    }
+#endif
+
+    __DSB();
+    __WFI();
+
+end_of_function:
+    __set_PRIMASK(primask);
+}
+
+#endif /* SCHEDULER_H_ */
+/* end of file */
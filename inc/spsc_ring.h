@@ -0,0 +1,190 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes spsc_ring
+ *
+ *  @package    spsc_ring
+ *  @brief      This module provides a lock-free single-producer/single-consumer
+ *              ring buffer, instantiated per event type, to pass events between
+ *              interrupt and thread context.
+ *
+ *  @details    `SPSC_RING_DEFINE(ring_name, prefix, type, capacity)` generates
+ *              the ring type `ring_name_t` and its `prefix` functions, so each
+ *              event type gets its own type-checked queue with no void pointers
+ *              or element sizes.
+ *
+ *              - **Indexes**: `head` is only written by the producer and `tail`
+ *                only by the consumer. Both run freely and wrap at 2^32; the
+ *                slot is `index & (capacity - 1)` and the fill level is
+ *                `head - tail`, so all slots are usable and no modulo is done.
+ *
+ *              - **Ordering**: the producer stores the element, then __DMB(),
+ *                then publishes `head`; the consumer reads `head`, __DMB(), then
+ *                the element, and __DMB() again before releasing the slot through
+ *                `tail`. No interrupt masking is needed on either side.
+ *
+ *              - **Batch drain**: prefixDrain() copies every pending element (up
+ *                to a limit) and releases them with one `tail` store, so a burst
+ *                costs one barrier pair instead of one per element.
+ *
+ *              - **Full ring**: prefixPush() drops the new element, counts it in
+ *                `dropped` and reports SPSC_RING_FULL; the producer never blocks.
+ *
+ *              Each ring must have exactly one producer context and one consumer
+ *              context, e.g. one ISR priority level and the main loop.
+ *
+ *  @file       spsc_ring.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef SPSC_RING_H_
+#define SPSC_RING_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    spscRingStatus
+ *  @typedef spsc_ring_status_t
+ *  @package    spsc_ring
+ *
+ *  @brief   Result of a ring operation.
+ */
+typedef enum spscRingStatus
+{
+    SPSC_RING_OK    = (uint8_t)(0u),    /**< Element pushed or popped */
+    SPSC_RING_FULL  = (uint8_t)(1u),    /**< No free slot, element dropped */
+    SPSC_RING_EMPTY = (uint8_t)(2u)     /**< Nothing to pop */
+} spsc_ring_status_t;
+
+/*==========================================
+ *             Private Macros
+ * ========================================== */
+
+/**
+ * @def SPSC_RING_DEFINE
+ * @package    spsc_ring
+ * @brief Generates a ring of `capacity` elements of `type`.
+ *
+ * @details Expands to the type `ring_name_t` and to the functions:
+ *
+ *              - `void prefixInit(ring_name_t *ring)`
+ *              - `spsc_ring_status_t prefixPush(ring_name_t *ring, const type *element)`
+ *              - `spsc_ring_status_t prefixPop(ring_name_t *ring, type *element)`
+ *              - `uint32_t prefixDrain(ring_name_t *ring, type *elements, uint32_t max)`
+ *              - `uint32_t prefixCount(const ring_name_t *ring)`
+ *
+ * @param ring_name Snake-case name of the ring type, e.g. key_events.
+ * @param prefix    camelCase prefix of the functions, e.g. keyEvents.
+ * @param type      Element type, copied by value.
+ * @param capacity  Number of slots, a power of two.
+ */
+#define SPSC_RING_DEFINE(ring_name, prefix, type, capacity)                                 \
+                                                                                            \
+_Static_assert((((capacity) & ((capacity) - 1u)) == 0u) && ((capacity) >= 2u),              \
+               #ring_name ": capacity must be a power of two");                             \
+                                                                                            \
+typedef struct ring_name##_s                                                                \
+{                                                                                           \
+    volatile uint32_t head;             /* Next slot to write, producer only */             \
+    volatile uint32_t tail;             /* Next slot to read, consumer only */              \
+    volatile uint32_t dropped;          /* Elements refused on a full ring */               \
+    type              slot[(capacity)];                                                     \
+} ring_name##_t;                                                                            \
+                                                                                            \
+static inline void prefix##Init(ring_name##_t *ring)                                        \
+{                                                                                           \
+    ring->head    = 0u;                                                                     \
+    ring->tail    = 0u;                                                                     \
+    ring->dropped = 0u;                                                                     \
+}                                                                                           \
+                                                                                            \
+static inline spsc_ring_status_t prefix##Push(ring_name##_t *ring, const type *element)     \
+{                                                                                           \
+    spsc_ring_status_t ret = SPSC_RING_OK;                                                  \
+                                                                                            \
+    uint32_t head = ring->head;                                                             \
+                                                                                            \
+    if ((head - ring->tail) >= (uint32_t)(capacity))                                        \
+    {                                                                                       \
+        ring->dropped++;                                                                    \
+        ret = SPSC_RING_FULL;                                                               \
+        goto end_of_function;                                                               \
+    }                                                                                       \
+                                                                                            \
+    ring->slot[head & ((uint32_t)(capacity) - 1u)] = *element;                              \
+                                                                                            \
+    __DMB();                            /* Element visible before the new head */           \
+                                                                                            \
+    ring->head = (head + 1u);                                                               \
+                                                                                            \
+end_of_function:                                                                            \
+    return ret;                                                                             \
+}                                                                                           \
+                                                                                            \
+static inline spsc_ring_status_t prefix##Pop(ring_name##_t *ring, type *element)            \
+{                                                                                           \
+    spsc_ring_status_t ret = SPSC_RING_OK;                                                  \
+                                                                                            \
+    uint32_t tail = ring->tail;                                                             \
+                                                                                            \
+    if (ring->head == tail)                                                                 \
+    {                                                                                       \
+        ret = SPSC_RING_EMPTY;                                                              \
+        goto end_of_function;                                                               \
+    }                                                                                       \
+                                                                                            \
+    __DMB();                            /* Head read before the element */                  \
+                                                                                            \
+    *element = ring->slot[tail & ((uint32_t)(capacity) - 1u)];                              \
+                                                                                            \
+    __DMB();                            /* Element read before the slot is released */      \
+                                                                                            \
+    ring->tail = (tail + 1u);                                                               \
+                                                                                            \
+end_of_function:                                                                            \
+    return ret;                                                                             \
+}                                                                                           \
+                                                                                            \
+static inline uint32_t prefix##Drain(ring_name##_t *ring, type *elements, uint32_t max)     \
+{                                                                                           \
+    uint32_t tail  = ring->tail;                                                            \
+    uint32_t count = (ring->head - tail);                                                   \
+    uint32_t index = 0u;                                                                    \
+                                                                                            \
+    count = (count < max) ? count : max;                                                    \
+                                                                                            \
+    __DMB();                            /* Head read before the elements */                 \
+                                                                                            \
+    for (index = 0u; index < count; index++)                                                \
+    {                                                                                       \
+        elements[index] = ring->slot[(tail + index) & ((uint32_t)(capacity) - 1u)];         \
+    }                                                                                       \
+                                                                                            \
+    __DMB();                            /* Elements read before the slots are released */   \
+                                                                                            \
+    ring->tail = (tail + count);                                                            \
+                                                                                            \
+    return count;                                                                           \
+}                                                                                           \
+                                                                                            \
+static inline uint32_t prefix##Count(const ring_name##_t *ring)                             \
+{                                                                                           \
+    return (ring->head - ring->tail);                                                       \
+}
+
+#endif /* SPSC_RING_H_ */
+/* end of file */
@@ -0,0 +1,255 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes trace_itm
+ *
+ *  @package    trace_itm
+ *  @brief      This module provides compact binary event tracing through the
+ *              ITM stimulus ports, timestamped with the DWT cycle counter and
+ *              sent over SWO.
+ *
+ *  @details    A trace point is one TRACE_EVENT(event, data) line. With
+ *              `TRACE_ITM_ENABLE` left at 0u it expands to nothing: no code, no
+ *              data, no register access.
+ *
+ *              - **Record**: every event has its own stimulus port, so the 1-byte
+ *                ITM packet header already tells the event apart. The 32-bit
+ *                payload is `(CYCCNT << 8) | data`: 24 bits of cycle count and
+ *                8 bits of event data. The counter wraps every 2^24 cycles
+ *                (about 100 ms at 168 MHz), so the host works on differences
+ *                modulo 2^24, which covers any key-to-LED latency.
+ *
+ *              - **Cost**: a counter load, a FIFO status load, a branch and a
+ *                store, with no wait. When the FIFO is full the event is
+ *                dropped and counted in `trace_itm_dropped`, so tracing never
+ *                stretches the timing it observes.
+ *
+ *              - **Decoding**: `tools/trace_decode.py` parses the raw SWO byte
+ *                stream and prints the latency histograms of the key path.
+ *
+ *              traceItmInit() sets up the TPIU for NRZ SWO on PB3. A probe that
+ *              configures the trace itself (e.g. the IDE SWV view) only needs
+ *              the ITM ports of TRACE_ITM_PORT_MASK enabled.
+ *
+ *  @file       trace_itm.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef TRACE_ITM_H_
+#define TRACE_ITM_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+#include "cycle_bench.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def TRACE_ITM_ENABLE
+ * @package    trace_itm
+ * @brief 1u compiles the trace points in, 0u removes them entirely.
+ */
+#ifndef TRACE_ITM_ENABLE
+#define TRACE_ITM_ENABLE            0u
+#endif
+
+/**
+ * @def TRACE_ITM_PORT_BASE
+ * @package    trace_itm
+ * @brief Stimulus port of event 0; port 0 is left to text output.
+ */
+#define TRACE_ITM_PORT_BASE         (uint32_t)(1U)
+
+/**
+ * @def TRACE_ITM_DATA_BITS
+ * @package    trace_itm
+ * @brief Width of the event data below the timestamp in a record.
+ */
+#define TRACE_ITM_DATA_BITS         (uint32_t)(8U)
+
+/**
+ * @def TRACE_ITM_UNLOCK
+ * @package    trace_itm
+ * @brief Lock access key of the CoreSight components.
+ */
+#define TRACE_ITM_UNLOCK            (uint32_t)(0xC5ACCE55U)
+
+/**
+ * @def TRACE_ITM_SPPR_NRZ
+ * @package    trace_itm
+ * @brief TPI->SPPR value selecting asynchronous NRZ (UART-like) SWO.
+ */
+#define TRACE_ITM_SPPR_NRZ          (uint32_t)(2U)
+
+/**
+ * @def TRACE_ITM_FFCR_BYPASS
+ * @package    trace_itm
+ * @brief TPI->FFCR value with the formatter off, raw ITM packets on SWO.
+ */
+#define TRACE_ITM_FFCR_BYPASS       (uint32_t)(0x100U)
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    traceEvent
+ *  @typedef trace_event_t
+ *  @package    trace_itm
+ *
+ *  @brief   Traced events, each sent on port TRACE_ITM_PORT_BASE + event.
+ *
+ *  @details Keep in sync with EVENTS in tools/trace_decode.py.
+ */
+typedef enum traceEvent
+{
+    TRACE_EVENT_KEY_EDGE    = (uint8_t)(0u),    /**< Key change seen, data: keys state */
+    TRACE_EVENT_PARITY      = (uint8_t)(1u),    /**< Output evaluation, data: LEDs set */
+    TRACE_EVENT_LED_COMMIT  = (uint8_t)(2u),    /**< LED store issued, data: LEDs set */
+    TRACE_EVENT_FRAME_SWAP  = (uint8_t)(3u),    /**< Display frame swapped, data: frame index */
+
+    MAX_TRACE_EVENTS
+} trace_event_t;
+
+/**
+ * @def TRACE_ITM_PORT_MASK
+ * @package    trace_itm
+ * @brief ITM->TER bits of the event ports.
+ */
+#define TRACE_ITM_PORT_MASK         (uint32_t)(((1UL << MAX_TRACE_EVENTS) - 1u) << TRACE_ITM_PORT_BASE)
+
+/*==========================================
+ *             Private Macros
+ * ========================================== */
+
+/**
+ * @def TRACE_EVENT
+ * @package    trace_itm
+ * @brief Emits one event record, or nothing when tracing is compiled out.
+ *
+ * @param event TRACE_EVENT_x.
+ * @param data  8-bit event data.
+ */
+#if (TRACE_ITM_ENABLE == 1u)
+#define TRACE_EVENT(event, data)    traceItmEmit((event), (uint8_t)(data))
+#else
+#define TRACE_EVENT(event, data)    ((void)0)
+#endif
+
+/**
+ * @def TRACE_INIT
+ * @package    trace_itm
+ * @brief Runs traceItmInit(), or nothing when tracing is compiled out.
+ *
+ * @param core_hz Core clock.
+ * @param swo_hz  SWO bit rate.
+ */
+#if (TRACE_ITM_ENABLE == 1u)
+#define TRACE_INIT(core_hz, swo_hz) traceItmInit((core_hz), (swo_hz))
+#else
+#define TRACE_INIT(core_hz, swo_hz) ((void)0)
+#endif
+
+#if (TRACE_ITM_ENABLE == 1u)
+
+/*==========================================
+ *         Private Global Variables
+ * ========================================== */
+
+/**
+ *  @var trace_itm_dropped
+ *  @package    trace_itm
+ *
+ *  @brief  Events dropped on a full ITM FIFO, read with the debugger.
+ */
+volatile uint32_t trace_itm_dropped __attribute__((weak, used)) = 0u;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         traceItmEmit
+ *  @package    trace_itm
+ *
+ *  @brief      Writes one timestamped event record without waiting.
+ *
+ *  @details    A stimulus port reads non-zero when its FIFO can take a write.
+ *              Events from an interrupt preempting this check may still fill
+ *              the FIFO first; the write is then lost by the ITM, like a drop.
+ *
+ *  @param      event [in] : Event, selects the stimulus port.
+ *  @param      data  [in] : Event data.
+ */
+static inline void traceItmEmit(trace_event_t event, uint8_t data)
+{
+    uint32_t record = ((benchNow() << TRACE_ITM_DATA_BITS) | data);
+    uint32_t port   = (TRACE_ITM_PORT_BASE + (uint32_t)event);
+
+    if (ITM->PORT[port].u32 != 0u)
+    {
+        ITM->PORT[port].u32 = record;
+    }
+    else
+    {
+        trace_itm_dropped++;
+    }
+}
+
+/**
+ *  @fn         traceItmInit
+ *  @package    trace_itm
+ *
+ *  @brief      Enables the cycle counter, the SWO pin and the event ports.
+ *
+ *  @details    It performs the following actions:
+ *
+ *                  - Starts DWT->CYCCNT through benchInit().
+ *                  - Enables the trace pins in asynchronous mode (TRACESWO on
+ *                    PB3, its reset function).
+ *                  - Sets the TPIU to NRZ at `swo_hz` with the formatter off.
+ *                  - Unlocks the ITM, enables it with sync packets and opens
+ *                    the event ports to unprivileged code.
+ *
+ *  @param      core_hz [in] : Core clock, the TPIU reference.
+ *  @param      swo_hz  [in] : SWO bit rate, a divisor of `core_hz`.
+ */
+static inline void traceItmInit(uint32_t core_hz, uint32_t swo_hz)
+{
+    (void)benchInit();
+
+    /* TRACESWO pin, asynchronous trace --------------------------------------*/
+    DBGMCU->CR = ((DBGMCU->CR & ~DBGMCU_CR_TRACE_MODE) | DBGMCU_CR_TRACE_IOEN);
+
+    /* TPIU: NRZ at swo_hz, raw ITM stream -----------------------------------*/
+    TPI->SPPR = TRACE_ITM_SPPR_NRZ;
+    TPI->ACPR = ((core_hz / swo_hz) - 1u);
+    TPI->FFCR = TRACE_ITM_FFCR_BYPASS;
+
+    /* ITM with the event ports ----------------------------------------------*/
+    ITM->LAR  = TRACE_ITM_UNLOCK;
+    ITM->TCR  =
+    (
+        (1UL << ITM_TCR_TraceBusID_Pos) |
+        ITM_TCR_SYNCENA_Msk |       /* Periodic sync packets */
+        ITM_TCR_ITMENA_Msk
+    );
+    ITM->TPR  = 0u;
+    ITM->TER |= TRACE_ITM_PORT_MASK;
+}
+
+#endif /* TRACE_ITM_ENABLE */
+
+#endif /* TRACE_ITM_H_ */
+/* end of file */
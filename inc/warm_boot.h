@@ -0,0 +1,323 @@
+/* =============================================================================
+ *  @ingroup    commun_includes
+ *  @addtogroup commun_includes warm_boot
+ *
+ *  @package    warm_boot
+ *  @brief      This module provides a warm restart path: the committed output
+ *              state is kept in backup SRAM, checked by a CRC, and put back on
+ *              the pins right after a watchdog reset.
+ *
+ *  @details    A watchdog reset puts every GPIO back to its reset state, so the
+ *              LEDs and the displays go dark until the full clock and port
+ *              bring-up has run again. With this module the application stores
+ *              its committed outputs and the configuration they belong to in a
+ *              `warm_boot_record_t` placed in `.bkpsram`, which the startup
+ *              code never initialises.
+ *
+ *              - **Record**: a magic word, the payload length, the payload and
+ *                a CRC-32 over all of them, computed by the CRC unit (one word
+ *                per AHB write). A record is only trusted when all three match,
+ *                so a cold boot, a reset in the middle of a save or a firmware
+ *                with another payload layout falls back to the full bring-up.
+ *
+ *              - **Reset cause**: warmBootResetCause() reads and clears the
+ *                RCC->CSR flags once, telling a watchdog reset from a software,
+ *                low-power or cold (power-on, brown-out, NRST pin) one.
+ *
+ *              - **Restore**: on a watchdog reset with a valid record, the
+ *                application enables the port clock, stores the saved BSRR word
+ *                and only then switches the pins to output, so they come up
+ *                driven with the saved levels. This runs first thing in main(),
+ *                on the 16 MHz reset clock, a few microseconds after reset; the
+ *                PLL and the remaining peripherals follow.
+ *
+ *              Backup SRAM is retained across any reset as long as VDD is
+ *              present. Keeping it on VBAT alone also needs the backup
+ *              regulator (PWR->CSR BRE), which is not enabled here.
+ *
+ *  @file       warm_boot.h
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+#ifndef WARM_BOOT_H_
+#define WARM_BOOT_H_
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/**
+ * @def WARM_BOOT_MAGIC
+ * @package    warm_boot
+ * @brief First word of a record written by warmBootSave().
+ */
+#define WARM_BOOT_MAGIC             (uint32_t)(0x57524D42U)
+
+/**
+ * @def WARM_BOOT_MAX_WORDS
+ * @package    warm_boot
+ * @brief Largest payload of a record, in 32-bit words.
+ */
+#define WARM_BOOT_MAX_WORDS         (uint32_t)(16U)
+
+/**
+ * @def WARM_BOOT_SECTION
+ * @package    warm_boot
+ * @brief Places a variable in backup SRAM, left untouched by the startup code.
+ */
+#define WARM_BOOT_SECTION           __attribute__((section(".bkpsram"), used, aligned(4)))
+
+/* Older CMSIS headers name the independent watchdog flag WDGRSTF */
+#if !defined(RCC_CSR_WDGRSTF) && defined(RCC_CSR_IWDGRSTF)
+#define RCC_CSR_WDGRSTF             RCC_CSR_IWDGRSTF
+#endif
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @enum    warmBootStatus
+ *  @typedef warm_boot_status_t
+ *  @package    warm_boot
+ *
+ *  @brief   Result of a record request.
+ */
+typedef enum warmBootStatus
+{
+    WARM_BOOT_OK        = (uint8_t)(0u),    /**< Record valid, payload copied */
+    WARM_BOOT_INVALID   = (uint8_t)(1u)     /**< No record, wrong length or CRC mismatch */
+} warm_boot_status_t;
+
+/**
+ *  @enum    warmBootCause
+ *  @typedef warm_boot_cause_t
+ *  @package    warm_boot
+ *
+ *  @brief   Reason of the last reset.
+ */
+typedef enum warmBootCause
+{
+    WARM_BOOT_CAUSE_COLD        = (uint8_t)(0u),    /**< Power-on, brown-out or NRST pin */
+    WARM_BOOT_CAUSE_WATCHDOG    = (uint8_t)(1u),    /**< IWDG or WWDG */
+    WARM_BOOT_CAUSE_SOFTWARE    = (uint8_t)(2u),    /**< NVIC_SystemReset() */
+    WARM_BOOT_CAUSE_LOW_POWER   = (uint8_t)(3u)     /**< Illegal Stop/Standby entry */
+} warm_boot_cause_t;
+
+/**
+ *  @struct  warmBootRecord
+ *  @typedef warm_boot_record_t
+ *  @package    warm_boot
+ *
+ *  @brief   State kept across a reset, to be defined with WARM_BOOT_SECTION.
+ */
+typedef struct warmBootRecord
+{
+    uint32_t magic;                             /**< WARM_BOOT_MAGIC once saved */
+    uint32_t words;                             /**< Payload length */
+    uint32_t payload[WARM_BOOT_MAX_WORDS];      /**< Saved state */
+    uint32_t crc;                               /**< CRC-32 of the fields above */
+} warm_boot_record_t;
+
+/*==========================================
+ *        Public Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         warmBootEnable
+ *  @package    warm_boot
+ *
+ *  @brief      Gives access to backup SRAM and to the CRC unit.
+ *
+ *  @details    Enables the PWR, BKPSRAM and CRC clocks and sets PWR->CR DBP,
+ *              without which backup SRAM ignores writes.
+ */
+static inline void warmBootEnable(void)
+{
+    RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+    RCC->AHB1ENR |= (RCC_AHB1ENR_BKPSRAMEN | RCC_AHB1ENR_CRCEN);
+
+    PWR->CR      |= PWR_CR_DBP;
+}
+
+/**
+ *  @fn         warmBootResetCause
+ *  @package    warm_boot
+ *
+ *  @brief      Decodes and clears the reset flags of RCC->CSR.
+ *
+ *  @details    NRST is pulsed on every reset, so PINRSTF is set along with any
+ *              other flag; it only means an external reset when nothing else
+ *              is. The flags are cleared, so the next reset reports alone.
+ *
+ *  @return     Reason of the last reset.
+ */
+static inline warm_boot_cause_t warmBootResetCause(void)
+{
+    warm_boot_cause_t ret = WARM_BOOT_CAUSE_COLD;
+
+    uint32_t flags = RCC->CSR;
+
+    if ((flags & (RCC_CSR_PORRSTF | RCC_CSR_BORRSTF)) != 0u)
+    {
+        ret = WARM_BOOT_CAUSE_COLD;
+    }
+    else if ((flags & (RCC_CSR_WDGRSTF | RCC_CSR_WWDGRSTF)) != 0u)
+    {
+        ret = WARM_BOOT_CAUSE_WATCHDOG;
+    }
+    else if ((flags & RCC_CSR_SFTRSTF) != 0u)
+    {
+        ret = WARM_BOOT_CAUSE_SOFTWARE;
+    }
+    else if ((flags & RCC_CSR_LPWRRSTF) != 0u)
+    {
+        ret = WARM_BOOT_CAUSE_LOW_POWER;
+    }
+
+    RCC->CSR |= RCC_CSR_RMVF;
+
+    return ret;
+}
+
+/**
+ *  @fn         warmBootCrc
+ *  @package    warm_boot
+ *
+ *  @brief      CRC-32 of a record, all fields but `crc`.
+ *
+ *  @details    The CRC unit takes one word per write (CRC-32/MPEG-2, poly
+ *              0x04C11DB7), so the cost is one store per word. Only the
+ *              `words` payload words in use are covered.
+ *
+ *  @param      record [in] : Record to be checked or sealed.
+ *  @param      words  [in] : Payload length, at most WARM_BOOT_MAX_WORDS.
+ *
+ *  @return     The CRC of the record.
+ */
+static inline uint32_t warmBootCrc(const warm_boot_record_t *record, uint32_t words)
+{
+    uint32_t index = 0u;
+
+    CRC->CR = CRC_CR_RESET;
+
+    CRC->DR = record->magic;
+    CRC->DR = record->words;
+
+    for (index = 0u; index < words; index++)
+    {
+        CRC->DR = record->payload[index];
+    }
+
+    return CRC->DR;
+}
+
+/**
+ *  @fn         warmBootSave
+ *  @package    warm_boot
+ *
+ *  @brief      Stores a payload into a record and seals it.
+ *
+ *  @details    The CRC is written last, so a reset in the middle of a save
+ *              leaves a record that warmBootLoad() rejects. Call it from one
+ *              context only, e.g. where the outputs are committed.
+ *
+ *  @param      record [out] : Record in backup SRAM.
+ *  @param      state  [in]  : Payload to be kept.
+ *  @param      words  [in]  : Payload length, at most WARM_BOOT_MAX_WORDS.
+ *
+ *  @return     WARM_BOOT_OK     : if the record was sealed.
+ *              WARM_BOOT_INVALID: if the payload does not fit.
+ */
+static inline warm_boot_status_t warmBootSave(warm_boot_record_t *record, const uint32_t *state,
+                                              uint32_t words)
+{
+    warm_boot_status_t ret = WARM_BOOT_INVALID;
+
+    uint32_t index = 0u;
+
+    if (words > WARM_BOOT_MAX_WORDS)
+    {
+        goto end_of_function;
+    }
+
+    for (index = 0u; index < words; index++)
+    {
+        record->payload[index] = state[index];
+    }
+
+    record->magic = WARM_BOOT_MAGIC;
+    record->words = words;
+    record->crc   = warmBootCrc(record, words);
+
+    ret = WARM_BOOT_OK;
+
+end_of_function:
+    return ret;
+}
+
+/**
+ *  @fn         warmBootLoad
+ *  @package    warm_boot
+ *
+ *  @brief      Copies the payload of a valid record.
+ *
+ *  @param      record [in]  : Record in backup SRAM.
+ *  @param      state  [out] : Payload, left untouched on failure.
+ *  @param      words  [in]  : Expected payload length.
+ *
+ *  @return     WARM_BOOT_OK     : if magic, length and CRC match.
+ *              WARM_BOOT_INVALID: otherwise.
+ */
+static inline warm_boot_status_t warmBootLoad(const warm_boot_record_t *record, uint32_t *state,
+                                              uint32_t words)
+{
+    warm_boot_status_t ret = WARM_BOOT_INVALID;
+
+    uint32_t index = 0u;
+
+    if ((record->magic != WARM_BOOT_MAGIC) || (record->words != words) ||
+        (words > WARM_BOOT_MAX_WORDS) || (warmBootCrc(record, words) != record->crc))
+    {
+        goto end_of_function;
+    }
+
+    for (index = 0u; index < words; index++)
+    {
+        state[index] = record->payload[index];
+    }
+
+    ret = WARM_BOOT_OK;
+
+end_of_function:
+    return ret;
+}
+
+/**
+ *  @fn         warmBootInvalidate
+ *  @package    warm_boot
+ *
+ *  @brief      Discards a record, e.g. before an intended shutdown.
+ *
+ *  @param      record [out] : Record in backup SRAM.
+ */
+static inline void warmBootInvalidate(warm_boot_record_t *record)
+{
+    record->magic = 0u;
+}
+
+#endif /* WARM_BOOT_H_ */
+/* end of file */
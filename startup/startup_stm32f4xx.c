@@ -0,0 +1,442 @@
+/* =============================================================================
+ *  @ingroup    STM32_baremetal_startup
+ *  @addtogroup STM32_baremetal_startup Startup
+ *
+ *  @package    STM32_baremetal
+ *  @brief      This module provides a minimal C startup for the STM32F40x/41x:
+ *              vector table, RAM initialisation and the jump to main().
+ *
+ *  @details    Reset_Handler() is the only code running before main():
+ *
+ *                  - **SystemInit()**: grants the FPU access and points VTOR at
+ *                    the vector table. It is weak, so a CMSIS system file can
+ *                    replace it.
+ *
+ *                  - **Copy**: .data (with any `.ramfunc` code) and .ccmram are
+ *                    copied from flash in 4-word LDM/STM bursts, 16 bytes per
+ *                    iteration.
+ *
+ *                  - **Clear**: .bss and .ccmbss are zeroed with 4-word STM
+ *                    bursts from four zeroed registers.
+ *
+ *                  - **No libc**: no __libc_init_array() and no constructors, so
+ *                    nothing from newlib is linked in and the image is the
+ *                    application plus this table. libgcc and `memcpy`/`memset`
+ *                    may still be needed, see stm32f4xx_flash.ld.
+ *
+ *              stm32f4xx_flash.ld aligns every section on 16 bytes, so the bursts
+ *              never need a tail. At the 16 MHz reset clock, zero wait states,
+ *              each 16-byte burst costs about 10 cycles: a few hundred bytes of
+ *              .data and .bss are ready well under 10 us after reset.
+ *
+ *              Every interrupt handler is a weak alias of Default_Handler(), so
+ *              the application only defines the ones it uses, by their CMSIS
+ *              names (e.g. EXTI0_IRQHandler).
+ *
+ *              The CCM RAM sits on the core data bus only: it can hold tables,
+ *              buffers and the stack, but not code, and the DMA can not reach
+ *              it. Code that has to run from RAM goes into `.ramfunc` (SRAM).
+ *
+ *  @file       startup_stm32f4xx.c
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+
+/* Implementeds */
+#include "stm32f4xx.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/* Cortex-M4 exceptions plus the 82 STM32F40x/41x interrupts */
+#define VECTOR_TABLE_SIZE   (uint32_t)(16u + 82u)
+
+/* 1u runs SystemInit() before the RAM initialisation */
+#ifndef STARTUP_CALL_SYSTEM_INIT
+#define STARTUP_CALL_SYSTEM_INIT 1u
+#endif
+
+/*==========================================
+ *             Private Macros
+ * ========================================== */
+
+/* Weak alias of Default_Handler, overridden by any handler of the same name */
+#define STARTUP_HANDLER(name) \
+    void name(void) __attribute__((weak, alias("Default_Handler")))
+
+/*==========================================
+ *          Private Global Variables
+ * ========================================== */
+
+/* Linker script symbols, only their addresses are meaningful */
+extern uint32_t _estack;
+extern uint32_t _sidata;
+extern uint32_t _sdata;
+extern uint32_t _edata;
+extern uint32_t _siccmram;
+extern uint32_t _sccmram;
+extern uint32_t _eccmram;
+extern uint32_t _sccmbss;
+extern uint32_t _eccmbss;
+extern uint32_t _sbss;
+extern uint32_t _ebss;
+
+/* Reset clock, updated by clockConfigInit() or a CMSIS system file */
+uint32_t SystemCoreClock __attribute__((weak)) = 16000000u;
+
+/*==========================================
+ *      Public Function Declaration
+ * ========================================== */
+
+int main(void);
+
+void Reset_Handler(void);
+void Default_Handler(void);
+void SystemInit(void) __attribute__((weak));
+
+/* Cortex-M4 exceptions */
+STARTUP_HANDLER(NMI_Handler);
+STARTUP_HANDLER(HardFault_Handler);
+STARTUP_HANDLER(MemManage_Handler);
+STARTUP_HANDLER(BusFault_Handler);
+STARTUP_HANDLER(UsageFault_Handler);
+STARTUP_HANDLER(SVC_Handler);
+STARTUP_HANDLER(DebugMon_Handler);
+STARTUP_HANDLER(PendSV_Handler);
+STARTUP_HANDLER(SysTick_Handler);
+
+/* STM32F40x/41x interrupts */
+STARTUP_HANDLER(WWDG_IRQHandler);
+STARTUP_HANDLER(PVD_IRQHandler);
+STARTUP_HANDLER(TAMP_STAMP_IRQHandler);
+STARTUP_HANDLER(RTC_WKUP_IRQHandler);
+STARTUP_HANDLER(FLASH_IRQHandler);
+STARTUP_HANDLER(RCC_IRQHandler);
+STARTUP_HANDLER(EXTI0_IRQHandler);
+STARTUP_HANDLER(EXTI1_IRQHandler);
+STARTUP_HANDLER(EXTI2_IRQHandler);
+STARTUP_HANDLER(EXTI3_IRQHandler);
+STARTUP_HANDLER(EXTI4_IRQHandler);
+STARTUP_HANDLER(DMA1_Stream0_IRQHandler);
+STARTUP_HANDLER(DMA1_Stream1_IRQHandler);
+STARTUP_HANDLER(DMA1_Stream2_IRQHandler);
+STARTUP_HANDLER(DMA1_Stream3_IRQHandler);
+STARTUP_HANDLER(DMA1_Stream4_IRQHandler);
+STARTUP_HANDLER(DMA1_Stream5_IRQHandler);
+STARTUP_HANDLER(DMA1_Stream6_IRQHandler);
+STARTUP_HANDLER(ADC_IRQHandler);
+STARTUP_HANDLER(CAN1_TX_IRQHandler);
+STARTUP_HANDLER(CAN1_RX0_IRQHandler);
+STARTUP_HANDLER(CAN1_RX1_IRQHandler);
+STARTUP_HANDLER(CAN1_SCE_IRQHandler);
+STARTUP_HANDLER(EXTI9_5_IRQHandler);
+STARTUP_HANDLER(TIM1_BRK_TIM9_IRQHandler);
+STARTUP_HANDLER(TIM1_UP_TIM10_IRQHandler);
+STARTUP_HANDLER(TIM1_TRG_COM_TIM11_IRQHandler);
+STARTUP_HANDLER(TIM1_CC_IRQHandler);
+STARTUP_HANDLER(TIM2_IRQHandler);
+STARTUP_HANDLER(TIM3_IRQHandler);
+STARTUP_HANDLER(TIM4_IRQHandler);
+STARTUP_HANDLER(I2C1_EV_IRQHandler);
+STARTUP_HANDLER(I2C1_ER_IRQHandler);
+STARTUP_HANDLER(I2C2_EV_IRQHandler);
+STARTUP_HANDLER(I2C2_ER_IRQHandler);
+STARTUP_HANDLER(SPI1_IRQHandler);
+STARTUP_HANDLER(SPI2_IRQHandler);
+STARTUP_HANDLER(USART1_IRQHandler);
+STARTUP_HANDLER(USART2_IRQHandler);
+STARTUP_HANDLER(USART3_IRQHandler);
+STARTUP_HANDLER(EXTI15_10_IRQHandler);
+STARTUP_HANDLER(RTC_Alarm_IRQHandler);
+STARTUP_HANDLER(OTG_FS_WKUP_IRQHandler);
+STARTUP_HANDLER(TIM8_BRK_TIM12_IRQHandler);
+STARTUP_HANDLER(TIM8_UP_TIM13_IRQHandler);
+STARTUP_HANDLER(TIM8_TRG_COM_TIM14_IRQHandler);
+STARTUP_HANDLER(TIM8_CC_IRQHandler);
+STARTUP_HANDLER(DMA1_Stream7_IRQHandler);
+STARTUP_HANDLER(FSMC_IRQHandler);
+STARTUP_HANDLER(SDIO_IRQHandler);
+STARTUP_HANDLER(TIM5_IRQHandler);
+STARTUP_HANDLER(SPI3_IRQHandler);
+STARTUP_HANDLER(UART4_IRQHandler);
+STARTUP_HANDLER(UART5_IRQHandler);
+STARTUP_HANDLER(TIM6_DAC_IRQHandler);
+STARTUP_HANDLER(TIM7_IRQHandler);
+STARTUP_HANDLER(DMA2_Stream0_IRQHandler);
+STARTUP_HANDLER(DMA2_Stream1_IRQHandler);
+STARTUP_HANDLER(DMA2_Stream2_IRQHandler);
+STARTUP_HANDLER(DMA2_Stream3_IRQHandler);
+STARTUP_HANDLER(DMA2_Stream4_IRQHandler);
+STARTUP_HANDLER(ETH_IRQHandler);
+STARTUP_HANDLER(ETH_WKUP_IRQHandler);
+STARTUP_HANDLER(CAN2_TX_IRQHandler);
+STARTUP_HANDLER(CAN2_RX0_IRQHandler);
+STARTUP_HANDLER(CAN2_RX1_IRQHandler);
+STARTUP_HANDLER(CAN2_SCE_IRQHandler);
+STARTUP_HANDLER(OTG_FS_IRQHandler);
+STARTUP_HANDLER(DMA2_Stream5_IRQHandler);
+STARTUP_HANDLER(DMA2_Stream6_IRQHandler);
+STARTUP_HANDLER(DMA2_Stream7_IRQHandler);
+STARTUP_HANDLER(USART6_IRQHandler);
+STARTUP_HANDLER(I2C3_EV_IRQHandler);
+STARTUP_HANDLER(I2C3_ER_IRQHandler);
+STARTUP_HANDLER(OTG_HS_EP1_OUT_IRQHandler);
+STARTUP_HANDLER(OTG_HS_EP1_IN_IRQHandler);
+STARTUP_HANDLER(OTG_HS_WKUP_IRQHandler);
+STARTUP_HANDLER(OTG_HS_IRQHandler);
+STARTUP_HANDLER(DCMI_IRQHandler);
+STARTUP_HANDLER(CRYP_IRQHandler);
+STARTUP_HANDLER(HASH_RNG_IRQHandler);
+STARTUP_HANDLER(FPU_IRQHandler);
+
+/*==========================================
+ *              Vector Table
+ * ========================================== */
+
+/**
+ *  @var        vector_table
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Initial stack pointer and exception vectors, first word of flash.
+ */
+void (* const vector_table[VECTOR_TABLE_SIZE])(void) __attribute__((section(".isr_vector"), used)) =
+{
+    (void (*)(void))(&_estack),
+    Reset_Handler,
+    NMI_Handler,
+    HardFault_Handler,
+    MemManage_Handler,
+    BusFault_Handler,
+    UsageFault_Handler,
+    0,
+    0,
+    0,
+    0,
+    SVC_Handler,
+    DebugMon_Handler,
+    0,
+    PendSV_Handler,
+    SysTick_Handler,
+
+    WWDG_IRQHandler,                    /* 0  */
+    PVD_IRQHandler,
+    TAMP_STAMP_IRQHandler,
+    RTC_WKUP_IRQHandler,
+    FLASH_IRQHandler,
+    RCC_IRQHandler,
+    EXTI0_IRQHandler,
+    EXTI1_IRQHandler,
+    EXTI2_IRQHandler,
+    EXTI3_IRQHandler,
+    EXTI4_IRQHandler,                   /* 10 */
+    DMA1_Stream0_IRQHandler,
+    DMA1_Stream1_IRQHandler,
+    DMA1_Stream2_IRQHandler,
+    DMA1_Stream3_IRQHandler,
+    DMA1_Stream4_IRQHandler,
+    DMA1_Stream5_IRQHandler,
+    DMA1_Stream6_IRQHandler,
+    ADC_IRQHandler,
+    CAN1_TX_IRQHandler,
+    CAN1_RX0_IRQHandler,                /* 20 */
+    CAN1_RX1_IRQHandler,
+    CAN1_SCE_IRQHandler,
+    EXTI9_5_IRQHandler,
+    TIM1_BRK_TIM9_IRQHandler,
+    TIM1_UP_TIM10_IRQHandler,
+    TIM1_TRG_COM_TIM11_IRQHandler,
+    TIM1_CC_IRQHandler,
+    TIM2_IRQHandler,
+    TIM3_IRQHandler,
+    TIM4_IRQHandler,                    /* 30 */
+    I2C1_EV_IRQHandler,
+    I2C1_ER_IRQHandler,
+    I2C2_EV_IRQHandler,
+    I2C2_ER_IRQHandler,
+    SPI1_IRQHandler,
+    SPI2_IRQHandler,
+    USART1_IRQHandler,
+    USART2_IRQHandler,
+    USART3_IRQHandler,
+    EXTI15_10_IRQHandler,               /* 40 */
+    RTC_Alarm_IRQHandler,
+    OTG_FS_WKUP_IRQHandler,
+    TIM8_BRK_TIM12_IRQHandler,
+    TIM8_UP_TIM13_IRQHandler,
+    TIM8_TRG_COM_TIM14_IRQHandler,
+    TIM8_CC_IRQHandler,
+    DMA1_Stream7_IRQHandler,
+    FSMC_IRQHandler,
+    SDIO_IRQHandler,
+    TIM5_IRQHandler,                    /* 50 */
+    SPI3_IRQHandler,
+    UART4_IRQHandler,
+    UART5_IRQHandler,
+    TIM6_DAC_IRQHandler,
+    TIM7_IRQHandler,
+    DMA2_Stream0_IRQHandler,
+    DMA2_Stream1_IRQHandler,
+    DMA2_Stream2_IRQHandler,
+    DMA2_Stream3_IRQHandler,
+    DMA2_Stream4_IRQHandler,            /* 60 */
+    ETH_IRQHandler,
+    ETH_WKUP_IRQHandler,
+    CAN2_TX_IRQHandler,
+    CAN2_RX0_IRQHandler,
+    CAN2_RX1_IRQHandler,
+    CAN2_SCE_IRQHandler,
+    OTG_FS_IRQHandler,
+    DMA2_Stream5_IRQHandler,
+    DMA2_Stream6_IRQHandler,
+    DMA2_Stream7_IRQHandler,            /* 70 */
+    USART6_IRQHandler,
+    I2C3_EV_IRQHandler,
+    I2C3_ER_IRQHandler,
+    OTG_HS_EP1_OUT_IRQHandler,
+    OTG_HS_EP1_IN_IRQHandler,
+    OTG_HS_WKUP_IRQHandler,
+    OTG_HS_IRQHandler,
+    DCMI_IRQHandler,
+    CRYP_IRQHandler,
+    HASH_RNG_IRQHandler,                /* 80 */
+    FPU_IRQHandler
+};
+
+/*==========================================
+ *      Private Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         startupCopyWords
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Copies a 16-byte aligned section in 4-word bursts.
+ *
+ *  @details    One LDM and one STM move 16 bytes per iteration, writing back
+ *              both pointers, so the loop body is four instructions.
+ *
+ *  @param      dst [out] : First word of the section in RAM.
+ *  @param      end [in]  : End of the section in RAM.
+ *  @param      src [in]  : Load image of the section in flash.
+ */
+static inline __attribute__((always_inline)) void startupCopyWords(uint32_t *dst, const uint32_t *end,
+                                                                   const uint32_t *src)
+{
+    __asm volatile
+    (
+        "1:                         \n"
+        "   cmp     %[dst], %[end]  \n"
+        "   bhs     2f              \n"
+        "   ldmia   %[src]!, {r4-r7}\n"
+        "   stmia   %[dst]!, {r4-r7}\n"
+        "   b       1b              \n"
+        "2:                         \n"
+        : [dst] "+r" (dst), [src] "+r" (src)
+        : [end] "r" (end)
+        : "r4", "r5", "r6", "r7", "cc", "memory"
+    );
+}
+
+/**
+ *  @fn         startupZeroWords
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Clears a 16-byte aligned section in 4-word bursts.
+ *
+ *  @param      dst [out] : First word of the section.
+ *  @param      end [in]  : End of the section.
+ */
+static inline __attribute__((always_inline)) void startupZeroWords(uint32_t *dst, const uint32_t *end)
+{
+    __asm volatile
+    (
+        "   movs    r4, #0          \n"
+        "   movs    r5, #0          \n"
+        "   movs    r6, #0          \n"
+        "   movs    r7, #0          \n"
+        "1:                         \n"
+        "   cmp     %[dst], %[end]  \n"
+        "   bhs     2f              \n"
+        "   stmia   %[dst]!, {r4-r7}\n"
+        "   b       1b              \n"
+        "2:                         \n"
+        : [dst] "+r" (dst)
+        : [end] "r" (end)
+        : "r4", "r5", "r6", "r7", "cc", "memory"
+    );
+}
+
+/**
+ *  @fn         SystemInit
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Core setup needed before any C code touches floats or IRQs.
+ *
+ *  @details    Grants full access to CP10/CP11 (the FPU) and points VTOR at
+ *              `vector_table`. The clock tree is left on the reset HSI, the
+ *              application brings it up with clockConfigInit().
+ */
+void SystemInit(void)
+{
+    SCB->CPACR |= ((3UL << 20u) | (3UL << 22u));    /* CP10 and CP11 full access */
+
+    SCB->VTOR   = (uint32_t)(uintptr_t)&vector_table[0];
+
+    __DSB();
+    __ISB();
+}
+
+/**
+ *  @fn         Reset_Handler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Entry point after reset: initialises RAM and calls main().
+ */
+void Reset_Handler(void)
+{
+#if (STARTUP_CALL_SYSTEM_INIT == 1u)
+    SystemInit();
+#endif
+
+    startupCopyWords(&_sdata, &_edata, &_sidata);
+    startupCopyWords(&_sccmram, &_eccmram, &_siccmram);
+
+    startupZeroWords(&_sbss, &_ebss);
+    startupZeroWords(&_sccmbss, &_eccmbss);
+
+    (void)main();
+
+    while (1)
+    {
+        /* main() is not expected to return */
+    }
+}
+
+/**
+ *  @fn         Default_Handler
+ *  @package    STM32_baremetal
+ *
+ *  @brief      Traps any exception or interrupt without a handler of its own.
+ *
+ *  @details    Spinning here keeps the offending state on the stack for the
+ *              debugger; IPSR tells which vector was taken.
+ */
+void Default_Handler(void)
+{
+    while (1)
+    {
+        /* Unhandled exception */
+    }
+}
+
+/* end of file */
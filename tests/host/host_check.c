@@ -0,0 +1,1085 @@
+/* =============================================================================
+ *  @ingroup    STM32_baremetal_tests
+ *  @addtogroup STM32_baremetal_tests host_check
+ *
+ *  @package    host_check
+ *  @brief      This program checks and times the pure-logic headers of `inc/`
+ *              on the host, before a rewrite of them is flashed.
+ *
+ *  @details    It is built once per `PARITY_KERNEL` and `DISPLAY_POLARITY` by
+ *              tests/host/Makefile, and returns non-zero on the first run with
+ *              a mismatch:
+ *
+ *              - **Parity**: the four byte kernels for every 8-bit input, and
+ *                parity32(), popcountSwar32() and the 4-lane kernels for random
+ *                words, against a bit-by-bit reference.
+ *
+ *              - **Font**: the `display_number`, `display_digit` and
+ *                `display_hexadecimal` views, the `*_char` tables and
+ *                displayFontLookup() against the separate code tables of the
+ *                original module, copied below.
+ *
+ *              - **Rules**: a 3-input parity table, as the one of the
+ *                OddOrEvenOnLed example, and an 8-input popcount and parity
+ *                table through rulesLookup() against the rule evaluated at run
+ *                time.
+ *
+ *              - **Formatters**: displayFormatU16(), displayFormatU32() and
+ *                displayFormatHex() for random and edge values, every width
+ *                and both blanking modes, against `snprintf` rendered through
+ *                the same original tables.
+ *
+ *              - **Packed words**: the DISPLAY_PACKED_RECIP100 split, the pair
+ *                tables and displayPackDecimal4() / displayPackHex4() /
+ *                displayPackFont4() for every 16-bit value, against
+ *                `snprintf("%04u")` / `"%04X"`.
+ *
+ *              - **Debounce**: debounceUpdate() over random sample streams,
+ *                against a separate counter per pin.
+ *
+ *              - **Marquee**: displayMarqueeTask() over random messages,
+ *                widths, periods and blink masks, against a naive window over
+ *                the message and the number of writes it implies.
+ *
+ *              After the checks, every kernel is run HOST_BENCH_CALLS times and
+ *              its rate is printed in millions of calls per second. The rates
+ *              compare kernels with each other on the same host; they are not
+ *              target cycle counts.
+ *
+ *  @file       host_check.c
+ *
+ *  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+ *  @date       14/10/2026
+ *
+ * =============================================================================*/
+
+/*==========================================
+ *             Private includes
+ * ========================================== */
+
+/* Dependencies of libc */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Implementeds */
+#include "parity.h"
+#include "display_segments.h"
+#include "display_format.h"
+#include "rules_table.h"
+#include "display_packed.h"
+#include "debounce.h"
+#include "display_marquee.h"
+
+/*==========================================
+ *             Private Defines
+ * ========================================== */
+
+/* Random words drawn by every differential check */
+#ifndef HOST_FUZZ_ROUNDS
+#define HOST_FUZZ_ROUNDS    (uint32_t)(1000000u)
+#endif
+
+/* Calls timed per kernel */
+#ifndef HOST_BENCH_CALLS
+#define HOST_BENCH_CALLS    (uint32_t)(50000000u)
+#endif
+
+/* Widest frame formatted, the 10 digits of UINT32_MAX */
+#define HOST_MAX_DIGITS     (uint8_t)(10u)
+
+/* Words of the parityLanesArray() and popcountArray32() buffers */
+#define HOST_ARRAY_WORDS    (uint32_t)(97u)
+
+/* Debounce sample streams, and samples per stream */
+#define HOST_DEBOUNCE_STREAMS   (uint32_t)(HOST_FUZZ_ROUNDS / 1000u)
+#define HOST_DEBOUNCE_SAMPLES   (uint32_t)(1000u)
+
+/* Marquee configurations, and task runs per configuration */
+#define HOST_MARQUEE_CONFIGS    (uint32_t)(HOST_FUZZ_ROUNDS / 500u)
+#define HOST_MARQUEE_RUNS       (uint32_t)(200u)
+
+/*==========================================
+ *             Private Macros
+ * ========================================== */
+
+/* Counts a failed check and reports its first occurrences */
+#define HOST_EXPECT(condition, ...)                                            \
+    do                                                                         \
+    {                                                                          \
+        if (!(condition))                                                      \
+        {                                                                      \
+            if (host_failures < 10u)                                           \
+            {                                                                  \
+                printf("FAIL %s:%d: ", __func__, __LINE__);                    \
+                printf(__VA_ARGS__);                                           \
+                printf("\n");                                                  \
+            }                                                                  \
+            host_failures++;                                                   \
+        }                                                                      \
+    } while (0)
+
+/* Times `calls` runs of `expression` of `value`, a running xorshift32 */
+#define HOST_BENCH(name, calls, expression)                                    \
+    do                                                                         \
+    {                                                                          \
+        uint32_t value = 0x9E3779B9u;                                          \
+        uint32_t sink  = 0u;                                                   \
+        uint32_t call  = 0u;                                                   \
+        double   start = hostSeconds();                                        \
+                                                                               \
+        for (call = 0u; call < (calls); call++)                                \
+        {                                                                      \
+            value ^= (value << 13u);                                           \
+            value ^= (value >> 17u);                                           \
+            value ^= (value << 5u);                                            \
+                                                                               \
+            sink += (uint32_t)(expression);                                    \
+        }                                                                      \
+                                                                               \
+        host_sink = sink;                                                      \
+                                                                               \
+        printf("  %-20s %10.1f Mops/s\n", (name),                             \
+               ((double)(calls) / (hostSeconds() - start)) * 1e-6);            \
+    } while (0)
+
+/* Rules of the checked tables, from the constant building blocks */
+#define HOST_PARITY_RULE(input)     (uint32_t)(RULES_PARITY8(input) + 0x10u)
+#define HOST_POPCOUNT_RULE(input)                                              \
+    (uint32_t)(RULES_POPCOUNT8(input) | (RULES_PARITY8(input) << 4u) | (RULES_BIT(input, 7u) << 8u))
+
+/*==========================================
+ *              Private Types
+ * ========================================== */
+
+/**
+ *  @struct  hostDisplay
+ *  @typedef host_display_t
+ *  @package host_check
+ *
+ *  @brief   Display written by the marquee checks through hostMarqueeWrite().
+ */
+typedef struct hostDisplay
+{
+    uint8_t  codes[DISPLAY_MARQUEE_MAX_DIGITS];     /**< Code of every digit */
+    uint32_t writes;                                /**< Hook calls so far */
+}host_display_t;
+
+/*==========================================
+ *         Private Global Variables
+ * ========================================== */
+
+/* Tables of the rules, expanded at compile time */
+static RULES_TABLE_DEFINE(host_parity_rules, 3, HOST_PARITY_RULE);
+static RULES_TABLE_DEFINE(host_popcount_rules, 8, HOST_POPCOUNT_RULE);
+
+/* Segment codes of the original display_number table */
+static const uint8_t reference_number[MAX_DISPLAY_NUM] =
+{
+    0b00111111, 0b00000110, 0b01011011, 0b01001111, 0b01100110, 0b01101101,
+    0b01111101, 0b00000111, 0b01111111, 0b01101111, 0b00000000
+};
+
+/* Segment codes of the original display_digit table */
+static const uint8_t reference_digit[MAX_DISPLAY_DIG] =
+{
+    0b01110111, 0b01111100, 0b00111001, 0b01011110, 0b01111001, 0b01110001,
+    0b00111101, 0b01110100, 0b00110000, 0b00011110, 0b01110101, 0b00111000,
+    0b00010101, 0b00110111, 0b00111111, 0b01110011, 0b01100111, 0b00110011,
+    0b01101101, 0b01111000, 0b00111110, 0b00011100, 0b00101010, 0b00110110,
+    0b01101110, 0b01011011, 0b00000000
+};
+
+/* Segment codes of the original display_hexadecimal table */
+static const uint8_t reference_hexadecimal[MAX_DISPLAY_HEX] =
+{
+    0b00111111, 0b00000110, 0b01011011, 0b01001111, 0b01100110, 0b01101101,
+    0b01111101, 0b00000111, 0b01111111, 0b01101111, 0b01110111, 0b01111100,
+    0b00111001, 0b01011110, 0b01111001, 0b01110001, 0b00000000
+};
+
+/* Failed checks of the run */
+static uint32_t host_failures = 0u;
+
+/* xorshift32 state, fixed so a failure can be replayed */
+static uint32_t host_seed = 0x2545F491u;
+
+/* Keeps the benchmarked results alive */
+static volatile uint32_t host_sink = 0u;
+
+/* Engines run by the benchmarks */
+static debounce_t        bench_debounce;
+static display_marquee_t bench_marquee;
+static host_display_t    bench_display;
+
+/*==========================================
+ *        Private Function Declaration
+ * ========================================== */
+
+/**
+ *  @fn         hostRandom
+ *  @package    host_check
+ *
+ *  @brief      Next word of the xorshift32 sequence.
+ *
+ *  @return     A pseudo-random word.
+ */
+static uint32_t hostRandom(void)
+{
+    host_seed ^= (host_seed << 13u);
+    host_seed ^= (host_seed >> 17u);
+    host_seed ^= (host_seed << 5u);
+
+    return host_seed;
+}
+
+/**
+ *  @fn         hostRandomWidth
+ *  @package    host_check
+ *
+ *  @brief      Random word kept to a random number of low bits.
+ *
+ *  @details    Uniform words almost never fit a narrow frame or have leading
+ *              zeros; shortening them covers every digit count evenly.
+ *
+ *  @return     A pseudo-random word of 0..32 significant bits.
+ */
+static uint32_t hostRandomWidth(void)
+{
+    uint32_t width = (hostRandom() % 33u);
+    uint32_t value = hostRandom();
+
+    return (width == 32u) ? value : (value & ((1UL << width) - 1u));
+}
+
+/**
+ *  @fn         hostCode
+ *  @package    host_check
+ *
+ *  @brief      Applies DISPLAY_POLARITY to a reference code, as the font does.
+ *
+ *  @param      code [in] : Common cathode code.
+ *
+ *  @return     The code as stored in `display_font`.
+ */
+static uint8_t hostCode(uint8_t code)
+{
+    return DISPLAY_FONT_CODE(code);
+}
+
+/**
+ *  @fn         referencePopcount
+ *  @package    host_check
+ *
+ *  @brief      Bit-by-bit popcount, the reference of every parity kernel.
+ *
+ *  @param      value [in] : Word to be evaluated.
+ *
+ *  @return     Number of '1' bits.
+ */
+static uint32_t referencePopcount(uint32_t value)
+{
+    uint32_t count = 0u;
+    uint32_t bit   = 0u;
+
+    for (bit = 0u; bit < 32u; bit++)
+    {
+        count += ((value >> bit) & 1u);
+    }
+
+    return count;
+}
+
+/**
+ *  @fn         referenceCode
+ *  @package    host_check
+ *
+ *  @brief      Code of a formatted character through the original tables.
+ *
+ *  @param      character [in] : Character printed by snprintf.
+ *
+ *  @return     The segment code for DISPLAY_POLARITY.
+ */
+static uint8_t referenceCode(char character)
+{
+    uint8_t ret = hostCode(reference_number[DISPLAY_NUM_NULL]);
+
+    if ((character >= '0') && (character <= '9'))
+    {
+        ret = hostCode(reference_number[character - '0']);
+    }
+    else if ((character >= 'A') && (character <= 'F'))
+    {
+        ret = hostCode(reference_hexadecimal[DISPLAY_HEX_A + (character - 'A')]);
+    }
+
+    return ret;
+}
+
+/**
+ *  @fn         referencePack4
+ *  @package    host_check
+ *
+ *  @brief      Packed word of four printed characters, through the original tables.
+ *
+ *  @param      text [in] : Four characters, the leftmost first.
+ *
+ *  @return     The expected packed word.
+ */
+static uint32_t referencePack4(const char *text)
+{
+    uint32_t word  = 0u;
+    uint32_t digit = 0u;
+
+    for (digit = 0u; digit < DISPLAY_PACKED_DIGITS; digit++)
+    {
+        word |= ((uint32_t)referenceCode(text[digit]) << (8u * digit));
+    }
+
+    return word;
+}
+
+/**
+ *  @fn         hostMarqueeWrite
+ *  @package    host_check
+ *
+ *  @brief      Marquee backend hook: stores the code and counts the call.
+ *
+ *  @param      display [inout] : The host_display_t being written.
+ *  @param      digit   [in]    : Digit position.
+ *  @param      code    [in]    : Segment code.
+ */
+static void hostMarqueeWrite(void *display, uint8_t digit, uint8_t code)
+{
+    host_display_t *host = (host_display_t *)display;
+
+    host->codes[digit] = code;
+    host->writes++;
+}
+
+/**
+ *  @fn         referenceFormat
+ *  @package    host_check
+ *
+ *  @brief      Expected frame of a formatter, built from snprintf.
+ *
+ *  @param      frame       [out] : Expected codes.
+ *  @param      digits      [in]  : Frame width.
+ *  @param      value       [in]  : Value to be shown.
+ *  @param      hexadecimal [in]  : 1u for "%X", 0u for "%u".
+ *  @param      blank_zeros [in]  : 1u for space padding, 0u for zero padding.
+ *
+ *  @return     DISPLAY_FORMAT_OK or DISPLAY_FORMAT_OVERFLOW.
+ */
+static display_format_status_t referenceFormat(uint8_t *frame, uint8_t digits, uint32_t value,
+                                               uint8_t hexadecimal, uint8_t blank_zeros)
+{
+    display_format_status_t ret = DISPLAY_FORMAT_OK;
+
+    char    text[16];
+    uint8_t index = 0u;
+    int     length = 0;
+
+    if (hexadecimal != 0u)
+    {
+        length = snprintf(text, sizeof(text), (blank_zeros != 0u) ? "%*X" : "%0*X", (int)digits, (unsigned)value);
+    }
+    else
+    {
+        length = snprintf(text, sizeof(text), (blank_zeros != 0u) ? "%*u" : "%0*u", (int)digits, (unsigned)value);
+    }
+
+    if (length > (int)digits)
+    {
+        memset(frame, hostCode(DISPLAY_GLYPH_MINUS), digits);
+
+        ret = DISPLAY_FORMAT_OVERFLOW;
+        goto end_of_function;
+    }
+
+    for (index = 0u; index < digits; index++)
+    {
+        frame[index] = referenceCode(text[index]);
+    }
+
+end_of_function:
+    return ret;
+}
+
+/**
+ *  @fn         checkParityKernels
+ *  @package    host_check
+ *
+ *  @brief      Byte kernels over every input, word kernels over random words.
+ */
+static void checkParityKernels(void)
+{
+    uint32_t value = 0u;
+    uint32_t round = 0u;
+
+    for (value = 0u; value < 256u; value++)
+    {
+        uint32_t count  = referencePopcount(value);
+        uint8_t  parity = (uint8_t)(count & 1u);
+
+        HOST_EXPECT(popcountLut8((uint8_t)value) == count, "popcountLut8(0x%02X)", (unsigned)value);
+        HOST_EXPECT(parityLut8((uint8_t)value) == parity, "parityLut8(0x%02X)", (unsigned)value);
+        HOST_EXPECT(parityNibble8((uint8_t)value) == parity, "parityNibble8(0x%02X)", (unsigned)value);
+        HOST_EXPECT(parityXorFold32(value) == parity, "parityXorFold32(0x%02X)", (unsigned)value);
+        HOST_EXPECT(parityBuiltin32(value) == parity, "parityBuiltin32(0x%02X)", (unsigned)value);
+        HOST_EXPECT(parity8((uint8_t)value) == parity, "parity8(0x%02X)", (unsigned)value);
+    }
+
+    for (round = 0u; round < HOST_FUZZ_ROUNDS; round++)
+    {
+        uint32_t count  = 0u;
+
+        value = (round < 2u) ? (0u - round) : hostRandom();
+        count = referencePopcount(value);
+
+        HOST_EXPECT(popcountSwar32(value) == count, "popcountSwar32(0x%08X)", (unsigned)value);
+        HOST_EXPECT(parityXorFold32(value) == (count & 1u), "parityXorFold32(0x%08X)", (unsigned)value);
+        HOST_EXPECT(parity32(value) == (count & 1u), "parity32(0x%08X)", (unsigned)value);
+    }
+}
+
+/**
+ *  @fn         checkLaneKernels
+ *  @package    host_check
+ *
+ *  @brief      4-lane kernels against the reference applied to each byte.
+ */
+static void checkLaneKernels(void)
+{
+    uint32_t words[HOST_ARRAY_WORDS];
+    uint32_t parities[HOST_ARRAY_WORDS];
+
+    uint32_t round = 0u;
+    uint32_t lane  = 0u;
+    uint32_t total = 0u;
+
+    for (round = 0u; round < HOST_FUZZ_ROUNDS; round++)
+    {
+        uint32_t value   = hostRandom();
+        uint32_t odd     = hostRandom();
+        uint32_t even    = hostRandom();
+        uint32_t counts  = 0u;
+        uint32_t lanes   = 0u;
+        uint32_t select  = 0u;
+        uint32_t mask    = 0u;
+
+        for (lane = 0u; lane < PARITY_SWAR_LANES; lane++)
+        {
+            uint32_t count = referencePopcount((value >> (8u * lane)) & 0xFFu);
+            uint32_t pick  = ((count & 1u) != 0u) ? odd : even;
+
+            counts |= (count << (8u * lane));
+            lanes  |= ((count & 1u) << (8u * lane));
+            select |= (pick & (0xFFUL << (8u * lane)));
+            mask   |= ((count & 1u) << lane);
+        }
+
+        HOST_EXPECT(parityLanes8x4(value) == lanes, "parityLanes8x4(0x%08X)", (unsigned)value);
+        HOST_EXPECT(parityLanesMask4(value) == mask, "parityLanesMask4(0x%08X)", (unsigned)value);
+        HOST_EXPECT(parityLanesSelect(value, odd, even) == select, "parityLanesSelect(0x%08X)", (unsigned)value);
+        HOST_EXPECT(popcountLanes8x4(value) == counts, "popcountLanes8x4(0x%08X)", (unsigned)value);
+        HOST_EXPECT(popcountLanesTotal(counts) == referencePopcount(value),
+                    "popcountLanesTotal(0x%08X)", (unsigned)counts);
+    }
+
+    /* Longer than PARITY_SWAR_BLOCK, with saturated words ------------------*/
+    for (round = 0u; round < HOST_ARRAY_WORDS; round++)
+    {
+        words[round] = ((round % 3u) == 0u) ? 0xFFFFFFFFu : hostRandom();
+        total       += referencePopcount(words[round]);
+    }
+
+    parityLanesArray(words, parities, HOST_ARRAY_WORDS);
+
+    for (round = 0u; round < HOST_ARRAY_WORDS; round++)
+    {
+        HOST_EXPECT(parities[round] == parityLanes8x4(words[round]), "parityLanesArray[%u]", (unsigned)round);
+    }
+
+    HOST_EXPECT(popcountArray32(words, HOST_ARRAY_WORDS) == total, "popcountArray32");
+    HOST_EXPECT(popcountArray32(words, 0u) == 0u, "popcountArray32 empty");
+}
+
+/**
+ *  @fn         checkFontViews
+ *  @package    host_check
+ *
+ *  @brief      Views, character tables and lookup against the original tables.
+ */
+static void checkFontViews(void)
+{
+    uint32_t index = 0u;
+
+    for (index = 0u; index < MAX_DISPLAY_NUM; index++)
+    {
+        HOST_EXPECT(display_number[index] == hostCode(reference_number[index]), "display_number[%u]", (unsigned)index);
+    }
+
+    for (index = 0u; index < MAX_DISPLAY_DIG; index++)
+    {
+        HOST_EXPECT(display_digit[index] == hostCode(reference_digit[index]), "display_digit[%u]", (unsigned)index);
+    }
+
+    for (index = 0u; index < MAX_DISPLAY_HEX; index++)
+    {
+        HOST_EXPECT(display_hexadecimal[index] == hostCode(reference_hexadecimal[index]),
+                    "display_hexadecimal[%u]", (unsigned)index);
+    }
+
+    for (index = 0u; index < (MAX_DISPLAY_NUM - 1u); index++)
+    {
+        HOST_EXPECT(display_number_char[index] == (char)('0' + index), "display_number_char[%u]", (unsigned)index);
+        HOST_EXPECT(displayFontLookup((char)('0' + index)) == display_number[index],
+                    "displayFontLookup('%c')", (char)('0' + index));
+    }
+
+    for (index = 0u; index < (MAX_DISPLAY_DIG - 1u); index++)
+    {
+        HOST_EXPECT(display_digit_char[index] == (char)('A' + index), "display_digit_char[%u]", (unsigned)index);
+        HOST_EXPECT(displayFontLookup((char)('A' + index)) == display_digit[index],
+                    "displayFontLookup('%c')", (char)('A' + index));
+        HOST_EXPECT(displayFontLookup((char)('a' + index)) == display_digit[index],
+                    "displayFontLookup('%c')", (char)('a' + index));
+    }
+
+    for (index = 0u; index < (MAX_DISPLAY_HEX - 1u); index++)
+    {
+        HOST_EXPECT(display_hexadecimal_char[index] == "0123456789ABCDEF"[index],
+                    "display_hexadecimal_char[%u]", (unsigned)index);
+    }
+
+    HOST_EXPECT(display_number_char[DISPLAY_NUM_NULL] == '\0', "display_number_char[NULL]");
+    HOST_EXPECT(display_digit_char[DISPLAY_DIG_NULL] == '\0', "display_digit_char[NULL]");
+    HOST_EXPECT(display_hexadecimal_char[DISPLAY_HEX_NULL] == '\0', "display_hexadecimal_char[NULL]");
+
+    HOST_EXPECT(displayFontLookup(' ') == DISPLAY_CODE_BLANK, "displayFontLookup(' ')");
+    HOST_EXPECT(displayFontLookup('-') == hostCode(DISPLAY_GLYPH_MINUS), "displayFontLookup('-')");
+    HOST_EXPECT(displayFontLookup((char)0xB0) == displayFontLookup('0'), "displayFontLookup(0xB0)");
+}
+
+/**
+ *  @fn         checkRulesTables
+ *  @package    host_check
+ *
+ *  @brief      Rules tables against their rule evaluated at run time.
+ *
+ *  @details    Every input of the 8-input range is looked up, so the 3-input
+ *              table is also checked for ignoring the bits above its width.
+ */
+static void checkRulesTables(void)
+{
+    uint32_t input = 0u;
+
+    for (input = 0u; input < 256u; input++)
+    {
+        uint32_t low = (input & 0x7u);
+
+        HOST_EXPECT(rulesLookup(host_parity_rules, 3u, input) == ((referencePopcount(low) & 1u) + 0x10u),
+                    "host_parity_rules[0x%02X]", (unsigned)input);
+        HOST_EXPECT(rulesLookup(host_popcount_rules, 8u, input) == (referencePopcount(input) | ((referencePopcount(input) & 1u) << 4u) | ((input >> 7u) << 8u)),
+                    "host_popcount_rules[0x%02X]", (unsigned)input);
+    }
+}
+
+/**
+ *  @fn         checkFormatValue
+ *  @package    host_check
+ *
+ *  @brief      Runs every formatter on one value, at one width and blanking.
+ *
+ *  @param      value       [in] : Value to be shown.
+ *  @param      digits      [in] : Frame width, 1..HOST_MAX_DIGITS.
+ *  @param      blank_zeros [in] : Passed to the formatters.
+ */
+static void checkFormatValue(uint32_t value, uint8_t digits, uint8_t blank_zeros)
+{
+    uint8_t expected[HOST_MAX_DIGITS];
+    uint8_t frame[HOST_MAX_DIGITS];
+
+    display_format_status_t want = DISPLAY_FORMAT_OK;
+    display_format_status_t got  = DISPLAY_FORMAT_OK;
+
+    want = referenceFormat(expected, digits, value, 0u, blank_zeros);
+    got  = displayFormatU32(frame, digits, value, blank_zeros);
+
+    HOST_EXPECT((got == want) && (memcmp(frame, expected, digits) == 0),
+                "displayFormatU32(%u, %u digits, blank %u)", (unsigned)value, digits, blank_zeros);
+
+    if (value <= UINT16_MAX)
+    {
+        got = displayFormatU16(frame, digits, (uint16_t)value, blank_zeros);
+
+        HOST_EXPECT((got == want) && (memcmp(frame, expected, digits) == 0),
+                    "displayFormatU16(%u, %u digits, blank %u)", (unsigned)value, digits, blank_zeros);
+    }
+
+    want = referenceFormat(expected, digits, value, 1u, blank_zeros);
+    got  = displayFormatHex(frame, digits, value, blank_zeros);
+
+    HOST_EXPECT((got == want) && (memcmp(frame, expected, digits) == 0),
+                "displayFormatHex(0x%X, %u digits, blank %u)", (unsigned)value, digits, blank_zeros);
+}
+
+/**
+ *  @fn         checkFormatters
+ *  @package    host_check
+ *
+ *  @brief      Formatters against snprintf, over edges and random values.
+ */
+static void checkFormatters(void)
+{
+    static const uint32_t edges[] =
+    {
+        0u, 1u, 9u, 10u, 15u, 16u, 99u, 100u, 255u, 256u, 999u, 1000u, 9999u,
+        10000u, 65535u, 65536u, 99999u, 999999999u, 1000000000u, 0xFFFFFFFFu
+    };
+
+    uint32_t round  = 0u;
+    uint32_t index  = 0u;
+    uint8_t  digits = 0u;
+
+    for (digits = 1u; digits <= HOST_MAX_DIGITS; digits++)
+    {
+        for (index = 0u; index < (sizeof(edges) / sizeof(edges[0])); index++)
+        {
+            checkFormatValue(edges[index], digits, 0u);
+            checkFormatValue(edges[index], digits, 1u);
+        }
+    }
+
+    for (round = 0u; round < (HOST_FUZZ_ROUNDS / 10u); round++)
+    {
+        uint32_t value = hostRandomWidth();
+
+        checkFormatValue(value, (uint8_t)(1u + (round % HOST_MAX_DIGITS)), (uint8_t)((round / HOST_MAX_DIGITS) & 1u));
+    }
+}
+
+/**
+ *  @fn         checkPackedWords
+ *  @package    host_check
+ *
+ *  @brief      Pair tables and packed words against snprintf.
+ *
+ *  @details    The reciprocal split is checked on its own over 0..9999 first,
+ *              so a failure there points at DISPLAY_PACKED_RECIP100 rather
+ *              than at the tables.
+ */
+static void checkPackedWords(void)
+{
+    const uint32_t overflow = ((uint32_t)hostCode(DISPLAY_GLYPH_MINUS) * 0x01010101u);
+
+    char     text[8];
+    uint32_t value = 0u;
+    uint32_t word  = 0u;
+    uint8_t  digit = 0u;
+
+    for (value = 0u; value <= DISPLAY_PACKED_MAX_DECIMAL; value++)
+    {
+        HOST_EXPECT(((value * DISPLAY_PACKED_RECIP100) >> DISPLAY_PACKED_SHIFT100) == (value / 100u),
+                    "DISPLAY_PACKED_RECIP100 split of %u", (unsigned)value);
+    }
+
+    for (value = 0u; value < MAX_DISPLAY_PAIR_DECIMAL; value++)
+    {
+        (void)snprintf(text, sizeof(text), "%02u", (unsigned)value);
+
+        HOST_EXPECT(display_pair_decimal[value] == (uint16_t)(referenceCode(text[0]) | (referenceCode(text[1]) << 8u)),
+                    "display_pair_decimal[%u]", (unsigned)value);
+    }
+
+    for (value = 0u; value < MAX_DISPLAY_PAIR_HEX; value++)
+    {
+        (void)snprintf(text, sizeof(text), "%02X", (unsigned)value);
+
+        HOST_EXPECT(display_pair_hex[value] == (uint16_t)(referenceCode(text[0]) | (referenceCode(text[1]) << 8u)),
+                    "display_pair_hex[0x%02X]", (unsigned)value);
+    }
+
+    for (value = 0u; value <= UINT16_MAX; value++)
+    {
+        (void)snprintf(text, sizeof(text), "%04X", (unsigned)value);
+
+        word = displayPackHex4((uint16_t)value);
+
+        HOST_EXPECT(word == referencePack4(text), "displayPackHex4(0x%04X)", (unsigned)value);
+        HOST_EXPECT(displayPackFont4(text) == word, "displayPackFont4(\"%s\")", text);
+
+        for (digit = 0u; digit < DISPLAY_PACKED_DIGITS; digit++)
+        {
+            HOST_EXPECT(displayPackDigit(word, digit) == referenceCode(text[digit]),
+                        "displayPackDigit(0x%04X, %u)", (unsigned)value, digit);
+        }
+
+        if (value <= DISPLAY_PACKED_MAX_DECIMAL)
+        {
+            (void)snprintf(text, sizeof(text), "%04u", (unsigned)value);
+
+            HOST_EXPECT(displayPackDecimal4((uint16_t)value) == referencePack4(text),
+                        "displayPackDecimal4(%u)", (unsigned)value);
+        }
+        else
+        {
+            HOST_EXPECT(displayPackDecimal4((uint16_t)value) == overflow, "displayPackDecimal4(%u) overflow", (unsigned)value);
+        }
+    }
+
+    HOST_EXPECT(DISPLAY_PACKED_OVERFLOW == overflow, "DISPLAY_PACKED_OVERFLOW");
+}
+
+/**
+ *  @fn         checkDebounce
+ *  @package    host_check
+ *
+ *  @brief      Vertical counters against one scalar counter per pin.
+ *
+ *  @details    Each stream draws a random mask and start level, then flips
+ *              every pin with a probability of 1/4 or 1/8 per sample, so
+ *              short bounces and settled changes both occur. The reference
+ *              counts the samples disagreeing with the stable level, resets
+ *              on an agreeing one and toggles at DEBOUNCE_SAMPLES.
+ */
+static void checkDebounce(void)
+{
+    debounce_t debounce;
+
+    uint8_t  counter[16];
+    uint32_t stream = 0u;
+    uint32_t sample = 0u;
+    uint32_t pin    = 0u;
+
+    for (stream = 0u; stream < HOST_DEBOUNCE_STREAMS; stream++)
+    {
+        uint16_t mask  = (uint16_t)hostRandom();
+        uint16_t raw   = (uint16_t)hostRandom();
+        uint16_t state = (uint16_t)(raw & mask);
+
+        memset(counter, 0, sizeof(counter));
+        debounceInit(&debounce, mask, raw);
+
+        for (sample = 0u; sample < HOST_DEBOUNCE_SAMPLES; sample++)
+        {
+            uint16_t noise    = (uint16_t)(hostRandom() & hostRandom());
+            uint16_t pressed  = 0u;
+            uint16_t released = 0u;
+            uint16_t result   = 0u;
+
+            if ((stream & 1u) != 0u)
+            {
+                noise &= (uint16_t)hostRandom();
+            }
+
+            raw   ^= noise;
+            result = debounceUpdate(&debounce, raw);
+
+            for (pin = 0u; pin < 16u; pin++)
+            {
+                uint16_t bit = (uint16_t)(1u << pin);
+
+                if ((raw & mask & bit) == (state & bit))
+                {
+                    counter[pin] = 0u;
+                }
+                else if (++counter[pin] == DEBOUNCE_SAMPLES)
+                {
+                    counter[pin] = 0u;
+                    state       ^= bit;
+
+                    if ((state & bit) != 0u)
+                    {
+                        pressed |= bit;
+                    }
+                    else
+                    {
+                        released |= bit;
+                    }
+                }
+            }
+
+            HOST_EXPECT((result == state) && (debounce.state == state),
+                        "debounceUpdate state 0x%04X, expected 0x%04X (stream %u, sample %u)",
+                        (unsigned)result, (unsigned)state, (unsigned)stream, (unsigned)sample);
+            HOST_EXPECT((debounce.pressed == pressed) && (debounce.released == released),
+                        "debounceUpdate edges 0x%04X/0x%04X, expected 0x%04X/0x%04X (stream %u, sample %u)",
+                        (unsigned)debounce.pressed, (unsigned)debounce.released,
+                        (unsigned)pressed, (unsigned)released, (unsigned)stream, (unsigned)sample);
+        }
+    }
+}
+
+/**
+ *  @fn         checkMarquee
+ *  @package    host_check
+ *
+ *  @brief      Marquee window, blink and writes against a naive model.
+ *
+ *  @details    After `run` task runs, the model shows the message (padded to
+ *              the display, or followed by `gap` blanks when it scrolls) from
+ *              position (run / step_ticks) modulo its length, with the
+ *              blinking digits blank on odd (run / blink_ticks). The hook must
+ *              have been called once per digit whose code changed. A message
+ *              too long for the ring and an invalid width are rejected.
+ */
+static void checkMarquee(void)
+{
+    static const char alphabet[] = "0123456789ABCDEFHLPU -";
+
+    display_marquee_t        marquee;
+    display_marquee_config_t config;
+    host_display_t           display;
+
+    char     text[DISPLAY_MARQUEE_MAX_RING + 8u];
+    uint8_t  message[DISPLAY_MARQUEE_MAX_RING];
+    uint8_t  shown[DISPLAY_MARQUEE_MAX_DIGITS];
+    uint32_t round = 0u;
+    uint32_t run   = 0u;
+    uint32_t index = 0u;
+
+    for (round = 0u; round < HOST_MARQUEE_CONFIGS; round++)
+    {
+        uint32_t characters = (hostRandom() % 48u);
+        uint32_t gap        = (hostRandom() % 8u);
+        uint32_t length     = 0u;
+        uint32_t mask       = hostRandom();
+        uint32_t writes     = 0u;
+        uint32_t scrolls    = 0u;
+
+        config.write       = hostMarqueeWrite;
+        config.display     = &display;
+        config.digits      = (uint8_t)(1u + (hostRandom() % ((round % 4u) == 0u ? DISPLAY_MARQUEE_MAX_DIGITS : 8u)));
+        config.step_ticks  = (uint16_t)(hostRandom() % 4u);
+        config.blink_ticks = (uint16_t)(hostRandom() % 4u);
+
+        mask   = (config.digits == 32u) ? mask : (mask & ((1UL << config.digits) - 1u));
+        length = (characters > config.digits) ? (characters + gap) : config.digits;
+
+        for (index = 0u; index < characters; index++)
+        {
+            text[index] = alphabet[hostRandom() % (sizeof(alphabet) - 1u)];
+        }
+
+        text[characters] = '\0';
+
+        for (index = 0u; index < length; index++)
+        {
+            message[index] = (index < characters) ? displayFontLookup(text[index]) : DISPLAY_CODE_BLANK;
+        }
+
+        memset(&display, 0, sizeof(display));
+        memset(shown, DISPLAY_CODE_BLANK, sizeof(shown));
+
+        HOST_EXPECT(displayMarqueeInit(&marquee, &config) == DISPLAY_MARQUEE_OK, "displayMarqueeInit, %u digits", config.digits);
+        HOST_EXPECT(display.writes == config.digits, "displayMarqueeInit writes %u", (unsigned)display.writes);
+
+        writes = config.digits;
+
+        HOST_EXPECT(displayMarqueeLoad(&marquee, text, (uint8_t)gap) == DISPLAY_MARQUEE_OK,
+                    "displayMarqueeLoad(\"%s\", %u)", text, (unsigned)gap);
+
+        displayMarqueeSetBlink(&marquee, mask);
+
+        scrolls = ((config.step_ticks != 0u) && (length > config.digits));
+
+        for (run = 0u; run <= HOST_MARQUEE_RUNS; run++)
+        {
+            uint32_t head = (scrolls != 0u) ? ((run / config.step_ticks) % length) : 0u;
+            uint32_t off  = (config.blink_ticks != 0u) ? ((run / config.blink_ticks) & 1u) : 0u;
+
+            for (index = 0u; index < config.digits; index++)
+            {
+                uint8_t code = (((off != 0u) && (((mask >> index) & 1u) != 0u)) ?
+                                DISPLAY_CODE_BLANK : message[(head + index) % length]);
+
+                writes      += (code != shown[index]);
+                shown[index] = code;
+            }
+
+            HOST_EXPECT(marquee.head == head, "marquee head %u, expected %u (\"%s\", run %u)",
+                        marquee.head, (unsigned)head, text, (unsigned)run);
+            HOST_EXPECT(memcmp(display.codes, shown, config.digits) == 0, "marquee window (\"%s\", run %u)", text, (unsigned)run);
+            HOST_EXPECT(display.writes == writes, "marquee writes %u, expected %u (\"%s\", run %u)",
+                        (unsigned)display.writes, (unsigned)writes, text, (unsigned)run);
+
+            displayMarqueeTask(&marquee);
+        }
+    }
+
+    /* Rejected requests leave the engine as it was --------------------------*/
+    memset(text, 'A', sizeof(text) - 1u);
+    text[sizeof(text) - 1u] = '\0';
+
+    config.digits = 4u;
+    (void)displayMarqueeInit(&marquee, &config);
+
+    HOST_EXPECT(displayMarqueeLoad(&marquee, text, 0u) == DISPLAY_MARQUEE_INVALID, "displayMarqueeLoad, too long");
+    HOST_EXPECT(marquee.length == 4u, "displayMarqueeLoad, too long, length %u", marquee.length);
+
+    config.digits = 0u;
+    HOST_EXPECT(displayMarqueeInit(&marquee, &config) == DISPLAY_MARQUEE_INVALID, "displayMarqueeInit, 0 digits");
+
+    config.digits = (uint8_t)(DISPLAY_MARQUEE_MAX_DIGITS + 1u);
+    HOST_EXPECT(displayMarqueeInit(&marquee, &config) == DISPLAY_MARQUEE_INVALID, "displayMarqueeInit, 33 digits");
+}
+
+/**
+ *  @fn         hostSeconds
+ *  @package    host_check
+ *
+ *  @brief      Monotonic time, for the benchmarks.
+ *
+ *  @return     Seconds since an arbitrary origin.
+ */
+static double hostSeconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((double)now.tv_sec + ((double)now.tv_nsec * 1e-9));
+}
+
+/* Formatter wrappers of the benchmarks, one frame each ------------------*/
+static uint32_t benchFormatU16(uint32_t value)
+{
+    uint8_t frame[5];
+
+    (void)displayFormatU16(frame, 5u, (uint16_t)value, 1u);
+
+    return frame[0];
+}
+
+static uint32_t benchFormatU32(uint32_t value)
+{
+    uint8_t frame[HOST_MAX_DIGITS];
+
+    (void)displayFormatU32(frame, HOST_MAX_DIGITS, value, 1u);
+
+    return frame[0];
+}
+
+static uint32_t benchFormatHex(uint32_t value)
+{
+    uint8_t frame[8];
+
+    (void)displayFormatHex(frame, 8u, value, 1u);
+
+    return frame[0];
+}
+
+/* Engine wrappers of the benchmarks, one update or task run each --------*/
+static uint32_t benchDebounce(uint32_t value)
+{
+    return debounceUpdate(&bench_debounce, (uint16_t)value);
+}
+
+static uint32_t benchMarquee(void)
+{
+    displayMarqueeTask(&bench_marquee);
+
+    return bench_display.writes;
+}
+
+/**
+ *  @fn         benchInitEngines
+ *  @package    host_check
+ *
+ *  @brief      Starts the engines timed by runBenchmarks().
+ *
+ *  @details    The marquee scrolls and blinks on every run, its worst case.
+ */
+static void benchInitEngines(void)
+{
+    const display_marquee_config_t config =
+    {
+        .write       = hostMarqueeWrite,
+        .display     = &bench_display,
+        .digits      = 8u,
+        .step_ticks  = 1u,
+        .blink_ticks = 1u
+    };
+
+    debounceInit(&bench_debounce, 0xFFFFu, 0u);
+
+    (void)displayMarqueeInit(&bench_marquee, &config);
+    (void)displayMarqueeLoad(&bench_marquee, "ODD OR EVEN 0123456789", 4u);
+
+    displayMarqueeSetBlink(&bench_marquee, 0x0Fu);
+}
+
+/**
+ *  @fn         runBenchmarks
+ *  @package    host_check
+ *
+ *  @brief      Times every kernel and prints its rate.
+ *
+ *  @details    Each kernel is inlined into its own loop, fed by the same
+ *              running xorshift, so every rate pays the same input cost. The
+ *              formatters and the marquee task run 10x fewer calls.
+ */
+static void runBenchmarks(void)
+{
+    const uint32_t calls  = HOST_BENCH_CALLS;
+    const uint32_t frames = (HOST_BENCH_CALLS / 10u);
+
+    printf("PARITY_KERNEL=%u DISPLAY_POLARITY=%u\n", (unsigned)PARITY_KERNEL, (unsigned)DISPLAY_POLARITY);
+
+    benchInitEngines();
+
+    HOST_BENCH("parityLut8",          calls,  parityLut8((uint8_t)value));
+    HOST_BENCH("parityNibble8",       calls,  parityNibble8((uint8_t)value));
+    HOST_BENCH("parityXorFold32",     calls,  parityXorFold32(value));
+    HOST_BENCH("parityBuiltin32",     calls,  parityBuiltin32(value));
+    HOST_BENCH("parity8",             calls,  parity8((uint8_t)value));
+    HOST_BENCH("parity32",            calls,  parity32(value));
+    HOST_BENCH("popcountLut8",        calls,  popcountLut8((uint8_t)value));
+    HOST_BENCH("popcountSwar32",      calls,  popcountSwar32(value));
+    HOST_BENCH("parityLanes8x4",      calls,  parityLanes8x4(value));
+    HOST_BENCH("parityLanesMask4",    calls,  parityLanesMask4(value));
+    HOST_BENCH("parityLanesSelect",   calls,  parityLanesSelect(value, 0x02020202u, 0x01010101u));
+    HOST_BENCH("popcountLanes8x4",    calls,  popcountLanes8x4(value));
+    HOST_BENCH("displayFontLookup",   calls,  displayFontLookup((char)value));
+    HOST_BENCH("rulesLookup",         calls,  rulesLookup(host_popcount_rules, 8u, value));
+    HOST_BENCH("displayFormatU16",    frames, benchFormatU16(value));
+    HOST_BENCH("displayFormatU32",    frames, benchFormatU32(value));
+    HOST_BENCH("displayFormatHex",    frames, benchFormatHex(value));
+    HOST_BENCH("displayPackDecimal4", calls,  displayPackDecimal4((uint16_t)(value % 10000u)));
+    HOST_BENCH("displayPackHex4",     calls,  displayPackHex4((uint16_t)value));
+    HOST_BENCH("debounceUpdate",      calls,  benchDebounce(value));
+    HOST_BENCH("displayMarqueeTask",  frames, benchMarquee());
+}
+
+/*==========================================
+ *              Main Function
+ * ========================================== */
+
+int main(void)
+{
+    checkParityKernels();
+    checkLaneKernels();
+    checkFontViews();
+    checkRulesTables();
+    checkFormatters();
+    checkPackedWords();
+    checkDebounce();
+    checkMarquee();
+
+    if (host_failures != 0u)
+    {
+        printf("PARITY_KERNEL=%u DISPLAY_POLARITY=%u: %u checks failed\n",
+               (unsigned)PARITY_KERNEL, (unsigned)DISPLAY_POLARITY, (unsigned)host_failures);
+
+        return 1;
+    }
+
+    runBenchmarks();
+
+    return 0;
+}
+
+/* end of file */
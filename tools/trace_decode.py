@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+# =============================================================================
+#  @package    trace_itm
+#  @brief      Host decoder of the ITM/SWO event records of trace_itm.h.
+#
+#  @details    Reads the raw SWO byte stream (formatter off, as set up by
+#              traceItmInit()), e.g. the file written by OpenOCD with
+#              `tpiu config internal swo.bin uart off <core_hz> <swo_hz>`, and
+#              prints the latency histograms of the key path:
+#
+#                  - key edge   -> parity result
+#                  - parity     -> LED committed
+#                  - key edge   -> LED committed
+#
+#              Each record is a 4-byte software source packet on port
+#              TRACE_ITM_PORT_BASE + event, payload `(CYCCNT << 8) | data`.
+#              Timestamps are 24-bit, so latencies are computed modulo 2^24.
+#
+#  @file       trace_decode.py
+#
+#  @author     Rafael V. Volkmer (rafael.v.volkmer@gmail.com)
+#  @date       14/10/2026
+#
+# =============================================================================
+
+import argparse
+import sys
+
+# Keep in sync with trace_event_t and TRACE_ITM_PORT_BASE in inc/trace_itm.h
+TRACE_ITM_PORT_BASE = 1
+EVENTS = ("key_edge", "parity", "led_commit", "frame_swap")
+
+TIMESTAMP_BITS = 24
+TIMESTAMP_MASK = (1 << TIMESTAMP_BITS) - 1
+
+ITM_OVERFLOW = 0x70
+PAYLOAD_SIZE = {1: 1, 2: 2, 3: 4}
+
+
+def parse_itm(stream):
+    """Yields (port, size, payload) for every software source packet.
+
+    Sync, timestamp, extension and hardware source packets are skipped. The
+    number of ITM overflow packets is returned through StopIteration.value.
+    """
+    overflows = 0
+    index = 0
+    length = len(stream)
+
+    while index < length:
+        header = stream[index]
+        index += 1
+
+        if header in (0x00, 0x80):
+            # Sync packet: zero bytes closed by 0x80
+            continue
+
+        if header == ITM_OVERFLOW:
+            overflows += 1
+            continue
+
+        size = header & 0x03
+
+        if size != 0:
+            count = PAYLOAD_SIZE[size]
+
+            if index + count > length:
+                break
+
+            payload = int.from_bytes(stream[index:index + count], "little")
+            index += count
+
+            if (header & 0x04) == 0:
+                yield (header >> 3, count, payload)
+            continue
+
+        # Timestamp or extension packet: continuation bytes carry bit 7
+        if header & 0x80:
+            while index < length and (stream[index] & 0x80):
+                index += 1
+            index += 1
+
+    return overflows
+
+
+class Histogram:
+    """Latency samples in cycles, shown in power-of-two buckets."""
+
+    def __init__(self, name):
+        self.name = name
+        self.samples = []
+
+    def add(self, start, end):
+        self.samples.append((end - start) & TIMESTAMP_MASK)
+
+    def show(self, core_hz, width):
+        print(f"\n{self.name}: {len(self.samples)} samples")
+
+        if not self.samples:
+            return
+
+        low = min(self.samples)
+        high = max(self.samples)
+        mean = sum(self.samples) / len(self.samples)
+
+        print(f"  min {low} / mean {mean:.1f} / max {high} cycles"
+              f"  ({low * 1e6 / core_hz:.3f} / {mean * 1e6 / core_hz:.3f} /"
+              f" {high * 1e6 / core_hz:.3f} us)")
+
+        buckets = {}
+
+        for sample in self.samples:
+            bucket = sample.bit_length()
+            buckets[bucket] = buckets.get(bucket, 0) + 1
+
+        peak = max(buckets.values())
+
+        for bucket in range(min(buckets), max(buckets) + 1):
+            count = buckets.get(bucket, 0)
+            first = 0 if bucket == 0 else (1 << (bucket - 1))
+            last = (1 << bucket) - 1
+            bar = "#" * ((count * width + peak - 1) // peak)
+
+            print(f"  {first:>9} .. {last:<9} {count:>7} {bar}")
+
+
+def decode(stream, core_hz, width, dump):
+    key_to_parity = Histogram("key edge -> parity")
+    parity_to_led = Histogram("parity -> LED commit")
+    key_to_led = Histogram("key edge -> LED commit")
+
+    counts = dict.fromkeys(EVENTS, 0)
+    pending_key = None
+    last_parity = None
+
+    packets = parse_itm(stream)
+    overflows = 0
+
+    while True:
+        try:
+            port, size, payload = next(packets)
+        except StopIteration as stop:
+            overflows = stop.value or 0
+            break
+
+        event = port - TRACE_ITM_PORT_BASE
+
+        if size != 4 or not 0 <= event < len(EVENTS):
+            continue
+
+        name = EVENTS[event]
+        stamp = payload >> 8
+        data = payload & 0xFF
+
+        counts[name] += 1
+
+        if dump:
+            print(f"{stamp:>8} {name:<10} 0x{data:02X}")
+
+        if name == "key_edge":
+            pending_key = stamp
+        elif name == "parity":
+            if pending_key is not None:
+                key_to_parity.add(pending_key, stamp)
+            last_parity = stamp
+        elif name == "led_commit":
+            if last_parity is not None:
+                parity_to_led.add(last_parity, stamp)
+            if pending_key is not None:
+                key_to_led.add(pending_key, stamp)
+                pending_key = None
+
+    print("events: " + ", ".join(f"{name} {count}" for name, count in counts.items()))
+    print(f"ITM overflows: {overflows}")
+
+    for histogram in (key_to_parity, parity_to_led, key_to_led):
+        histogram.show(core_hz, width)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__ or "Decode trace_itm.h SWO records.")
+    parser.add_argument("input", help="raw SWO capture, '-' for stdin")
+    parser.add_argument("--core-hz", type=float, default=168e6,
+                        help="core clock of the capture, for the us columns (default 168 MHz)")
+    parser.add_argument("--width", type=int, default=50, help="histogram bar width")
+    parser.add_argument("--dump", action="store_true", help="also print every record")
+    args = parser.parse_args()
+
+    if args.input == "-":
+        stream = sys.stdin.buffer.read()
+    else:
+        with open(args.input, "rb") as capture:
+            stream = capture.read()
+
+    decode(stream, args.core_hz, args.width, args.dump)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+
+# end of file